@@ -2,11 +2,276 @@
 
 
 #include "graph.hpp"
+#include "parallel.hpp"
+#include <atomic>
+#include <cmath>
+#include <thread>
 using namespace graph;
 
+// hot-path counters compile away unless the library is built with -DGRAPH_STATS
+#ifdef GRAPH_STATS
+#define STAT_RESET() (stats = AlgorithmStats())
+#define STAT_ADD(counter, amount) (stats.counter += (amount))
+#define STAT_PEAK(counter, value) (stats.counter = (value) > stats.counter ? (value) : stats.counter)
+#else
+#define STAT_RESET() ((void)0)
+#define STAT_ADD(counter, amount) ((void)0)
+#define STAT_PEAK(counter, value) ((void)0)
+#endif
+
+// ============================
+//         HELPERS SECTION
+// ============================
+
+namespace {
+
+    // counters of the last call on this thread, see Algorithms::getStats; algorithms count only on the
+    // calling thread (never inside parallelFor workers), so concurrent calls neither race nor mix
+    thread_local AlgorithmStats stats = AlgorithmStats();
+
+    /**
+     * @brief Sorts items in place by ascending key(item), breaking ties by the item itself.
+     *        Heap sort, so it needs no extra memory and is O(n log n) even on hub rows.
+     * 
+     * @param items The array to sort.
+     * @param count Number of items.
+     * @param key Maps an item to its sort key.
+     */
+    template <typename Key>
+    void sortByKey(int* items, int count, Key key) {
+        auto less = [&](int a, int b) {
+            long long ka = key(a), kb = key(b);
+            return ka < kb || (ka == kb && a < b);
+        };
+        auto siftDown = [&](int root, int end) {
+            while (2 * root + 1 < end) {
+                int child = 2 * root + 1;
+                if (child + 1 < end && less(items[child], items[child + 1])) child++;
+                if (!less(items[root], items[child])) return;
+                int temp = items[root];
+                items[root] = items[child];
+                items[child] = temp;
+                root = child;
+            }
+        };
+        for (int i = count / 2 - 1; i >= 0; i--) {
+            siftDown(i, count);
+        }
+        for (int end = count - 1; end > 0; end--) {
+            int temp = items[0];
+            items[0] = items[end];
+            items[end] = temp;
+            siftDown(0, end);
+        }
+    }
+
+    /**
+     * @brief Renumbers representative ids (each a vertex in [0, n)) into 0..k-1,
+     *        in order of the smallest vertex of each group.
+     * 
+     * @param raw raw[v] is the representative of v.
+     * @param n Number of vertices.
+     * @param labels Output array of size n with the compact ids.
+     * @return int The number of groups k.
+     */
+    int compactLabels(const int* raw, int n, int* labels) {
+        int* idOf = new int[n];
+        for (int v = 0; v < n; v++) {
+            idOf[v] = -1;
+        }
+        int count = 0;
+        for (int v = 0; v < n; v++) {
+            if (idOf[raw[v]] == -1) {
+                idOf[raw[v]] = count++;
+            }
+            labels[v] = idOf[raw[v]];
+        }
+        delete[] idOf;
+        return count;
+    }
+
+    /**
+     * @brief out[j] = min(out[j], dik + in[j]) over a row segment. The rows never alias and the loop
+     *        is branch-free, so with a constant count it vectorizes even under -O2.
+     */
+    inline void minPlusRow(int* __restrict out, const int* __restrict in, int dik, int count) {
+        for (int j = 0; j < count; j++) {
+            int through = dik + in[j];
+            out[j] = through < out[j] ? through : out[j];
+        }
+    }
+
+    /**
+     * @brief Min-plus update of one Floyd-Warshall tile: for every k, i, j in the tile ranges,
+     *        dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j]). Rows with dist[i][k] unreachable
+     *        are skipped, and so is row k itself (a no-op while dist[k][k] >= 0, and it would alias).
+     * 
+     * @param dist The V x V row-major matrix.
+     * @param V Row stride.
+     * @param i0, i1 Row range [i0, i1).
+     * @param j0, j1 Column range [j0, j1).
+     * @param k0, k1 Intermediate vertex range [k0, k1).
+     * @param inf The unreachable sentinel.
+     */
+    template <int Width>
+    void minPlusTile(int* dist, int V, int i0, int i1, int j0, int j1, int k0, int k1, int inf) {
+        for (int k = k0; k < k1; k++) {
+            const int* rowK = dist + (long long)k * V + j0;
+            for (int i = i0; i < i1; i++) {
+                int* rowI = dist + (long long)i * V;
+                int dik = rowI[k];
+                if (dik >= inf || i == k) continue;
+                if (j1 - j0 == Width) minPlusRow(rowI + j0, rowK, dik, Width); // full tile: fixed trip count
+                else minPlusRow(rowI + j0, rowK, dik, j1 - j0);
+            }
+        }
+    }
+
+
+    /**
+     * @brief Runs Dijkstra from every vertex over a CSR snapshot, splitting the sources between threads.
+     *        Each thread owns a PriorityQueue (lazy insertion) and a visited array. Adds to the stats counters.
+     * 
+     * @param V Number of vertices.
+     * @param offsets, targets, weights The CSR rows (non-negative weights).
+     * @param distances Output V x V matrix, 2147483647 for unreachable pairs.
+     * @param numThreads Number of threads.
+     */
+    void dijkstraAllSources(int V, long long* offsets, int* targets, int* weights, int* distances, int numThreads) {
+        if (numThreads < 1) numThreads = 1;
+        long long* settled = new long long[numThreads];
+        long long* scanned = new long long[numThreads];
+        long long* inserts = new long long[numThreads];
+        bool** visitedOf = new bool*[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            settled[t] = scanned[t] = inserts[t] = 0;
+            visitedOf[t] = new bool[V];
+        }
+
+        // lazy insertion leaves at most one heap entry per arc, plus the source
+        int heapCapacity = (int)offsets[V] + 1;
+        parallelFor(V, numThreads, [&](int begin, int end, int t) {
+            bool* visited = visitedOf[t];
+            PriorityQueue pq(heapCapacity);
+            for (int source = begin; source < end; source++) {
+                int* dist = distances + (long long)source * V;
+                for (int v = 0; v < V; v++) {
+                    dist[v] = 2147483647;
+                    visited[v] = false;
+                }
+                dist[source] = 0;
+                pq.insert(source, 0);
+                inserts[t]++;
+                while (!pq.isEmpty()) {
+                    int u = pq.extractMin();
+                    if (visited[u]) continue;
+                    visited[u] = true;
+                    settled[t]++;
+                    for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                        int v = targets[e];
+                        if (!visited[v] && dist[u] + weights[e] < dist[v]) {
+                            dist[v] = dist[u] + weights[e];
+                            pq.insert(v, dist[v]);
+                            inserts[t]++;
+                        }
+                    }
+                    scanned[t] += offsets[u + 1] - offsets[u];
+                }
+            }
+        }, 4);
+
+        for (int t = 0; t < numThreads; t++) {
+            STAT_ADD(verticesSettled, settled[t]);
+            STAT_ADD(edgesScanned, scanned[t]);
+            STAT_ADD(heapInserts, inserts[t]);
+            STAT_ADD(heapExtracts, inserts[t]);
+            delete[] visitedOf[t];
+        }
+        delete[] visitedOf;
+        delete[] settled;
+        delete[] scanned;
+        delete[] inserts;
+    }
+
+    /**
+     * @brief Bellman-Ford in its queue-based form (SPFA): only vertices whose distance just dropped
+     *        are rescanned. A vertex whose shortest path would need V or more arcs proves a negative cycle.
+     * 
+     * @param V Number of vertices.
+     * @param offsets, targets, weights The CSR rows.
+     * @param dist Distances, set up by the caller (2147483647 for unreached) and updated in place.
+     * @param parent Predecessor of each vertex on its path, or nullptr.
+     * @param start The source vertex, or -1 to start from every vertex at once
+     *        (a virtual source joined to all vertices, as in Johnson's algorithm).
+     * @return true If no negative cycle is reachable from the sources.
+     */
+    bool shortestPathFaster(int V, long long* offsets, int* targets, int* weights, int* dist, int* parent, int start) {
+        bool* queued = new bool[V];
+        int* arcsOnPath = new int[V];
+        Queue queue;
+        for (int v = 0; v < V; v++) {
+            queued[v] = start == -1;
+            arcsOnPath[v] = 0;
+            if (start == -1) queue.enqueue(v);
+        }
+        if (start != -1) {
+            queued[start] = true;
+            queue.enqueue(start);
+        }
+
+        bool ok = true;
+        while (!queue.isEmpty() && ok) {
+            int u = queue.dequeue();
+            queued[u] = false;
+            STAT_ADD(verticesSettled, 1);
+            STAT_ADD(edgesScanned, offsets[u + 1] - offsets[u]);
+            for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                int v = targets[e];
+                long long through = (long long)dist[u] + weights[e];
+                if (through >= dist[v]) continue;
+                dist[v] = (int)through;
+                if (parent != nullptr) parent[v] = u;
+                arcsOnPath[v] = arcsOnPath[u] + 1;
+                STAT_ADD(relaxSuccesses, 1);
+                if (arcsOnPath[v] >= V) {
+                    ok = false;
+                    break;
+                }
+                if (!queued[v]) {
+                    queued[v] = true;
+                    queue.enqueue(v);
+                    STAT_PEAK(queuePeak, queue.getSize());
+                }
+            }
+        }
+        delete[] queued;
+        delete[] arcsOnPath;
+        return ok;
+    }
+
+}
+
 namespace graph{
     
 
+// ============================
+//         STATS SECTION
+// ============================
+
+    /**
+     * @brief Returns the hot-path counters recorded by the most recent Algorithms call made on the
+     *        calling thread. Every thread has its own counters, so algorithms running concurrently on
+     *        different threads do not race or overwrite each other's results.
+     *        Counting is compiled in only with -DGRAPH_STATS; otherwise every counter stays 0
+     *        and the algorithms carry no counting overhead.
+     * 
+     * @return AlgorithmStats A copy of the counters.
+     */
+    AlgorithmStats Algorithms::getStats() {
+        return stats;
+    }
+
+
 // ============================
 //         BFS SECTION
 // ============================
@@ -25,26 +290,30 @@ namespace graph{
         if (start < 0 || start >= g.getNumVertices()) {
             throw std::out_of_range("Invalid start vertex in BFS");
         }
+        STAT_RESET();
         Graph bfsTree(g.getNumVertices());
         bool* visited = new bool[g.getNumVertices()];
         for (int i = 0; i < g.getNumVertices(); ++i) {
         visited[i] = false;
         }
         Node** adjList = g.getAdjList();
-        Queue queue(g.getNumVertices());
+        Queue queue;
         visited[start]= true;
         queue.enqueue(start);
 
         while (!queue.isEmpty())
         {
             int current=queue.dequeue();
+            STAT_ADD(verticesSettled, 1);
             Node* neighbor = adjList[current];
             while (neighbor != nullptr) {
                 int v = neighbor->vertex;
+                STAT_ADD(edgesScanned, 1);
                 if (!visited[v]){
                     visited[v]=true;
                     bfsTree.addDirectedEdge(current,v,neighbor->weight);
                     queue.enqueue(v);
+                    STAT_PEAK(queuePeak, queue.getSize());
                 }
                 neighbor= neighbor->next;
             }
@@ -53,6 +322,53 @@ namespace graph{
         return bfsTree;
     }
 
+    /**
+     * @brief Performs BFS traversal over a compressed graph and builds a BFS tree.
+     *        Each row is decoded once, when its vertex is dequeued.
+     * 
+     * @param g The compressed graph.
+     * @param start The starting vertex for BFS.
+     * @return Graph The BFS tree rooted at 'start'.
+     */
+    Graph Algorithms::bfs(CompressedGraph& g, int start){
+        if (start < 0 || start >= g.getNumVertices()) {
+            throw std::out_of_range("Invalid start vertex in BFS");
+        }
+        STAT_RESET();
+        int vertexNum = g.getNumVertices();
+        Graph bfsTree(vertexNum);
+        bool* visited = new bool[vertexNum];
+        for (int i = 0; i < vertexNum; ++i) {
+            visited[i] = false;
+        }
+        int* neighbors = new int[g.getMaxDegree()];
+        int* weights = new int[g.getMaxDegree()];
+        Queue queue;
+        visited[start] = true;
+        queue.enqueue(start);
+
+        while (!queue.isEmpty())
+        {
+            int current = queue.dequeue();
+            STAT_ADD(verticesSettled, 1);
+            int count = g.decodeNeighbors(current, neighbors, weights);
+            STAT_ADD(edgesScanned, count);
+            for (int i = 0; i < count; i++) {
+                int v = neighbors[i];
+                if (!visited[v]) {
+                    visited[v] = true;
+                    bfsTree.addDirectedEdge(current, v, weights[i]);
+                    queue.enqueue(v);
+                    STAT_PEAK(queuePeak, queue.getSize());
+                }
+            }
+        }
+        delete[] visited;
+        delete[] neighbors;
+        delete[] weights;
+        return bfsTree;
+    }
+
 
 // ============================
 //         DFS SECTION
@@ -72,6 +388,7 @@ namespace graph{
         if (start < 0 || start >= g.getNumVertices()) {
             throw std::out_of_range("Invalid start vertex in DFS");
         }
+        STAT_RESET();
         int vertexNum = g.getNumVertices();
         Graph dfsTree(vertexNum);
     
@@ -80,7 +397,7 @@ namespace graph{
             visited[i] = false;
     
         Node** adjList = g.getAdjList();
-        Stack stack(vertexNum);
+        Stack stack;
     
         stack.push(start);
         visited[start] = true;  // ⭐ סימון ברגע שדוחפים
@@ -89,15 +406,18 @@ namespace graph{
             int current = stack.pop();
             if (current == 2147483647 || current < 0 || current >= vertexNum)
                 continue;
+            STAT_ADD(verticesSettled, 1);
     
             Node* neighbor = adjList[current];
             while (neighbor != nullptr) {
                 int v = neighbor->vertex;
+                STAT_ADD(edgesScanned, 1);
     
                 if (v >= 0 && v < vertexNum && !visited[v]) {
                     visited[v] = true;  // ⭐ מונע דחיפה כפולה
                     dfsTree.addDirectedEdge(current, v, neighbor->weight);
                     stack.push(v);
+                    STAT_PEAK(queuePeak, stack.getSize());
                 }
     
                 neighbor = neighbor->next;
@@ -108,6 +428,53 @@ namespace graph{
         return dfsTree;
     }
 
+    /**
+     * @brief Performs DFS traversal over a compressed graph and builds a DFS tree.
+     *        Same visiting rule as the Graph version: vertices are marked when pushed.
+     * 
+     * @param g The compressed graph.
+     * @param start The starting vertex for DFS.
+     * @return Graph The DFS tree rooted at 'start'.
+     */
+    Graph Algorithms::dfs(CompressedGraph& g, int start) {
+        if (start < 0 || start >= g.getNumVertices()) {
+            throw std::out_of_range("Invalid start vertex in DFS");
+        }
+        STAT_RESET();
+        int vertexNum = g.getNumVertices();
+        Graph dfsTree(vertexNum);
+        bool* visited = new bool[vertexNum];
+        for (int i = 0; i < vertexNum; ++i)
+            visited[i] = false;
+        int* neighbors = new int[g.getMaxDegree()];
+        int* weights = new int[g.getMaxDegree()];
+        Stack stack;
+
+        stack.push(start);
+        visited[start] = true;
+
+        while (!stack.isEmpty()) {
+            int current = stack.pop();
+            STAT_ADD(verticesSettled, 1);
+            int count = g.decodeNeighbors(current, neighbors, weights);
+            STAT_ADD(edgesScanned, count);
+            for (int i = 0; i < count; i++) {
+                int v = neighbors[i];
+                if (!visited[v]) {
+                    visited[v] = true;
+                    dfsTree.addDirectedEdge(current, v, weights[i]);
+                    stack.push(v);
+                    STAT_PEAK(queuePeak, stack.getSize());
+                }
+            }
+        }
+
+        delete[] visited;
+        delete[] neighbors;
+        delete[] weights;
+        return dfsTree;
+    }
+
 // ============================
 //         DIJKSTRA SECTION
 // ============================
@@ -129,6 +496,8 @@ namespace graph{
             distances[v] = distances[u] + weight;
             parent[v] = u;
             pq.insert(v, distances[v]); 
+            STAT_ADD(relaxSuccesses, 1);
+            STAT_ADD(heapInserts, 1);
         }
     }
 
@@ -142,11 +511,22 @@ namespace graph{
      * @return Graph The shortest-path tree as a directed graph.
      * 
      * @throws std::out_of_range If the start vertex is not within the valid range.
+     * @throws std::invalid_argument If the graph has a negative weight (use bellmanFord instead).
      */
     Graph Algorithms::dijkstra(Graph& g, int start) {
         if (start < 0 || start >= g.getNumVertices()) {
             throw std::out_of_range("Invalid start vertex in DIJKSTRA");
         }
+        long long arcs = 0;
+        for (int u = 0; u < g.getNumVertices(); u++) {
+            for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+                if (n->weight < 0) {
+                    throw std::invalid_argument("Dijkstra requires non-negative weights.");
+                }
+                arcs++;
+            }
+        }
+        STAT_RESET();
         int vertexNum = g.getNumVertices();
         int* distances = new int[vertexNum];
         int* parent = new int[vertexNum];
@@ -160,18 +540,23 @@ namespace graph{
     
         distances[start] = 0;
     
-        PriorityQueue pq(vertexNum);
+        // lazy insertion: every successful relaxation adds an entry, at most one per arc
+        PriorityQueue pq((int)arcs + 1);
         pq.insert(start, 0);
+        STAT_ADD(heapInserts, 1);
     
         while (!pq.isEmpty()) {
             int u = pq.extractMin();
+            STAT_ADD(heapExtracts, 1);
             if (visited[u]) continue;
             visited[u] = true;
+            STAT_ADD(verticesSettled, 1);
     
             Node* neighbor = g.getAdjList()[u];
             while (neighbor != nullptr) {
                 int v = neighbor->vertex;
                 int weight = neighbor->weight;
+                STAT_ADD(edgesScanned, 1);
     
                 relax(u, v, weight, distances, parent, pq); 
     
@@ -206,6 +591,7 @@ namespace graph{
      * @return Graph The resulting MST as an undirected graph.
      */
     Graph Algorithms::prim(Graph& g) {
+        STAT_RESET();
         int V = g.getNumVertices();
         Graph mst(V);
         bool* visited = new bool[V];
@@ -218,23 +604,41 @@ namespace graph{
             parent[i] = -1;
         }
     
+        if (V == 0) {
+            delete[] visited;
+            delete[] parent;
+            delete[] key;
+            return mst;
+        }
+        long long arcs = 0;
+        for (int u = 0; u < V; u++) {
+            for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) arcs++;
+        }
         key[0] = 0;
-        PriorityQueue pq(V);
+        // lazy insertion: every key improvement adds an entry, at most one per arc
+        PriorityQueue pq((int)arcs + 1);
         pq.insert(0, 0);
+        STAT_ADD(heapInserts, 1);
     
         while (!pq.isEmpty()) {
             int u = pq.extractMin();
+            STAT_ADD(heapExtracts, 1);
+            if (visited[u]) continue; // stale entry of an already settled vertex
             visited[u] = true;
+            STAT_ADD(verticesSettled, 1);
     
             Node* neighbor = g.getAdjList()[u];
             while (neighbor != nullptr) {
                 int v = neighbor->vertex;
                 int weight = neighbor->weight;
+                STAT_ADD(edgesScanned, 1);
     
                 if (!visited[v] && weight < key[v]) {
                     key[v] = weight;
                     parent[v] = u;
                     pq.insert(v, key[v]);
+                    STAT_ADD(relaxSuccesses, 1);
+                    STAT_ADD(heapInserts, 1);
                 }
     
                 neighbor = neighbor->next;
@@ -268,6 +672,7 @@ namespace graph{
      * @return Graph The resulting MST as an undirected graph.
      */
     Graph Algorithms::kruskal(Graph& g) {
+        STAT_RESET();
         int V = g.getNumVertices();
         Edge* edges = new Edge[V * V];
         int edgeCount = 0;
@@ -278,6 +683,7 @@ namespace graph{
             while (neighbor != nullptr) {
                 int v = neighbor->vertex;
                 int w = neighbor->weight;
+                STAT_ADD(edgesScanned, 1);
                 if (u < v) {
                     edges[edgeCount++] = {u, v, w};
                 }
@@ -311,11 +717,2965 @@ namespace graph{
             if (uSet != vSet) {
                 mst.addEdge(e.src, e.dst, e.weight);
                 uf.unite(uSet, vSet);
+                STAT_ADD(relaxSuccesses, 1);
             }
         }
+        STAT_ADD(findSteps, uf.getFindSteps());
 
         delete[] edges;
         return mst;
 
         }
-}
\ No newline at end of file
+
+
+// ============================
+//   TRIANGLE COUNTING SECTION
+// ============================
+    /**
+     * @brief Counts the triangles of an undirected graph (built with addEdge).
+     *        Every edge is oriented from the endpoint with the lower (degree, id) rank to the higher one,
+     *        so each triangle is found exactly once and hub vertices keep short out-lists.
+     *        The triangles closed by an oriented edge u -> v are the common entries of the two
+     *        sorted out-lists, found with a linear merge over a CSR snapshot of the graph.
+     *        Self-loops and parallel edges are ignored.
+     * 
+     * @param g The input graph (undirected).
+     * @param perVertex Optional output array of size V; perVertex[v] receives the number of triangles through v.
+     * @param numThreads Number of threads used to scan the vertices.
+     * @return long long The total number of triangles.
+     */
+    long long Algorithms::countTriangles(Graph& g, long long* perVertex, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        if (numThreads < 1) numThreads = 1;
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+
+        // build the degree-ordered orientation; rows stay sorted by id
+        long long* outOff = new long long[V + 1];
+        outOff[0] = 0;
+        for (int u = 0; u < V; u++) {
+            long long du = offsets[u + 1] - offsets[u];
+            long long count = 0;
+            for (long long i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                if (v == u || (i > offsets[u] && targets[i - 1] == v)) continue;
+                long long dv = offsets[v + 1] - offsets[v];
+                if (du < dv || (du == dv && u < v)) count++;
+            }
+            outOff[u + 1] = outOff[u] + count;
+        }
+        int* out = new int[outOff[V]];
+        STAT_ADD(verticesSettled, V);
+        STAT_ADD(edgesScanned, outOff[V]);
+        for (int u = 0; u < V; u++) {
+            long long du = offsets[u + 1] - offsets[u];
+            long long pos = outOff[u];
+            for (long long i = offsets[u]; i < offsets[u + 1]; i++) {
+                int v = targets[i];
+                if (v == u || (i > offsets[u] && targets[i - 1] == v)) continue;
+                long long dv = offsets[v + 1] - offsets[v];
+                if (du < dv || (du == dv && u < v)) out[pos++] = v;
+            }
+        }
+
+        // per-thread totals; vertex counts go straight into perVertex on one thread and into one shared
+        // relaxed-atomic array otherwise, so the extra memory does not grow with numThreads
+        long long* totals = new long long[numThreads];
+        for (int t = 0; t < numThreads; t++) totals[t] = 0;
+        if (perVertex != nullptr) {
+            for (int i = 0; i < V; i++) perVertex[i] = 0;
+        }
+        std::atomic<long long>* shared = nullptr;
+        if (perVertex != nullptr && numThreads > 1) {
+            shared = new std::atomic<long long>[V];
+            for (int i = 0; i < V; i++) shared[i].store(0, std::memory_order_relaxed);
+        }
+        auto credit = [&](int x, long long amount) {
+            if (shared != nullptr) shared[x].fetch_add(amount, std::memory_order_relaxed);
+            else perVertex[x] += amount;
+        };
+
+        parallelFor(V, numThreads, [&](int begin, int end, int t) {
+            long long found = 0;
+            for (int u = begin; u < end; u++) {
+                long long atU = 0;
+                for (long long e = outOff[u]; e < outOff[u + 1]; e++) {
+                    int v = out[e];
+                    long long a = outOff[u], aEnd = outOff[u + 1];
+                    long long b = outOff[v], bEnd = outOff[v + 1];
+                    long long closed = 0;
+                    while (a < aEnd && b < bEnd) {
+                        int x = out[a], y = out[b];
+                        if (x == y) {
+                            closed++;
+                            if (perVertex != nullptr) credit(x, 1);
+                        }
+                        a += (x <= y);
+                        b += (y <= x);
+                    }
+                    found += closed;
+                    atU += closed;
+                    if (perVertex != nullptr && closed > 0) credit(v, closed);
+                }
+                if (perVertex != nullptr && atU > 0) credit(u, atU);
+            }
+            totals[t] += found;
+        });
+
+        long long total = 0;
+        for (int t = 0; t < numThreads; t++) {
+            total += totals[t];
+        }
+        if (shared != nullptr) {
+            for (int i = 0; i < V; i++) perVertex[i] = shared[i].load(std::memory_order_relaxed);
+            delete[] shared;
+        }
+
+        delete[] totals;
+        delete[] outOff;
+        delete[] out;
+        return total;
+    }
+
+
+// ============================
+//       REORDER SECTION
+// ============================
+    /**
+     * @brief Relabels the vertices of a graph to improve memory locality of traversals.
+     *        order[newId] = oldId is computed by the chosen strategy, then the graph is rebuilt
+     *        so that vertex order[i] becomes vertex i and every adjacency list is ascending.
+     *        All components are covered, and the edge set (directions and weights) is preserved.
+     * 
+     * @param g The input graph.
+     * @param strategy The relabeling strategy.
+     * @param perm Output array of size V; perm[oldId] receives the new id of the vertex.
+     * @return Graph The relabeled graph.
+     */
+    Graph Algorithms::reorder(Graph& g, ReorderStrategy strategy, int* perm) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        STAT_ADD(verticesSettled, V);
+        STAT_ADD(edgesScanned, csr.getNumArcs());
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+
+        int* order = new int[V];
+        bool* placed = new bool[V];
+        for (int i = 0; i < V; i++) {
+            order[i] = i;
+            placed[i] = false;
+        }
+        auto degree = [&](int v) { return offsets[v + 1] - offsets[v]; };
+
+        // vertices by ascending degree, used to pick component roots
+        int* byDegree = new int[V];
+        for (int i = 0; i < V; i++) byDegree[i] = i;
+        sortByKey(byDegree, V, degree);
+
+        if (strategy == REORDER_DEGREE) {
+            sortByKey(order, V, [&](int v) { return -degree(v); });
+        }
+        else if (strategy == REORDER_BFS || strategy == REORDER_RCM) {
+            // BFS from every unvisited root; RCM starts at low-degree vertices
+            // and visits neighbors by ascending degree, then reverses the order
+            bool rcm = (strategy == REORDER_RCM);
+            int* buffer = new int[V];
+            int count = 0;
+            Queue queue;
+            for (int r = 0; r < V; r++) {
+                int root = rcm ? byDegree[r] : r;
+                if (placed[root]) continue;
+                placed[root] = true;
+                queue.enqueue(root);
+                while (!queue.isEmpty()) {
+                    int u = queue.dequeue();
+                    order[count++] = u;
+                    int fresh = 0;
+                    for (long long i = offsets[u]; i < offsets[u + 1]; i++) {
+                        int v = targets[i];
+                        if (!placed[v]) {
+                            placed[v] = true;
+                            buffer[fresh++] = v;
+                        }
+                    }
+                    if (rcm) sortByKey(buffer, fresh, degree);
+                    for (int i = 0; i < fresh; i++) {
+                        queue.enqueue(buffer[i]);
+                    }
+                }
+            }
+            if (rcm) {
+                for (int i = 0, j = V - 1; i < j; i++, j--) {
+                    int temp = order[i];
+                    order[i] = order[j];
+                    order[j] = temp;
+                }
+            }
+            delete[] buffer;
+        }
+        else if (strategy == REORDER_GORDER) {
+            // Gorder-lite: score[x] counts the links (direct or through a shared neighbor) between x
+            // and the last `window` placed vertices; the next vertex is the best-scored candidate
+            // around the last placed one, falling back to the highest-degree unplaced vertex.
+            const int window = 5;
+            long long hubCap = 16;
+            while (hubCap * hubCap < V) hubCap *= 2; // skip sibling expansion through hubs
+            long long* score = new long long[V];
+            for (int i = 0; i < V; i++) score[i] = 0;
+
+            auto touch = [&](int v, int delta) {
+                for (long long i = offsets[v]; i < offsets[v + 1]; i++) {
+                    int u = targets[i];
+                    score[u] += delta;
+                    if (degree(u) > hubCap) continue;
+                    for (long long j = offsets[u]; j < offsets[u + 1]; j++) {
+                        score[targets[j]] += delta;
+                    }
+                }
+            };
+
+            int fallback = V - 1; // walks byDegree from the highest degree down
+            for (int count = 0; count < V; count++) {
+                int next = -1;
+                if (count > 0) {
+                    int last = order[count - 1];
+                    for (long long i = offsets[last]; i < offsets[last + 1]; i++) {
+                        int u = targets[i];
+                        if (!placed[u] && (next == -1 || score[u] > score[next] || (score[u] == score[next] && u < next))) next = u;
+                        if (degree(u) > hubCap) continue;
+                        for (long long j = offsets[u]; j < offsets[u + 1]; j++) {
+                            int x = targets[j];
+                            if (!placed[x] && (next == -1 || score[x] > score[next] || (score[x] == score[next] && x < next))) next = x;
+                        }
+                    }
+                }
+                if (next == -1) {
+                    while (placed[byDegree[fallback]]) fallback--;
+                    next = byDegree[fallback];
+                }
+                placed[next] = true;
+                order[count] = next;
+                touch(next, 1);
+                if (count >= window) touch(order[count - window], -1);
+            }
+            delete[] score;
+        }
+
+        for (int i = 0; i < V; i++) {
+            perm[order[i]] = i;
+        }
+
+        // rebuild: insert each row in descending new-id order so the prepended lists end up ascending
+        Graph relabeled(V);
+        long long maxRow = 0;
+        for (int u = 0; u < V; u++) {
+            if (degree(u) > maxRow) maxRow = degree(u);
+        }
+        int* row = new int[maxRow];
+        for (int nu = 0; nu < V; nu++) {
+            int u = order[nu];
+            int count = (int)degree(u);
+            long long base = offsets[u];
+            for (int i = 0; i < count; i++) row[i] = i;
+            sortByKey(row, count, [&](int i) { return -(long long)perm[targets[base + i]]; });
+            for (int i = 0; i < count; i++) {
+                relabeled.addDirectedEdge(nu, perm[targets[base + row[i]]], weights[base + row[i]]);
+            }
+        }
+
+        delete[] row;
+        delete[] order;
+        delete[] placed;
+        delete[] byDegree;
+        return relabeled;
+    }
+
+
+// ============================
+//  CONNECTED COMPONENTS SECTION
+// ============================
+    /**
+     * @brief Labels the connected components of a graph (weakly connected for directed arcs).
+     *        With one thread every arc is fed to a UnionFind. With more threads it runs Afforest:
+     *        two rounds link every vertex to its first neighbors, a sample finds the giant component,
+     *        and only vertices outside it scan the rest of their arcs (outgoing and incoming),
+     *        all on a lock-free ConcurrentUnionFind.
+     *        Labels are compact: components are numbered 0, 1, ... in order of their smallest vertex.
+     * 
+     * @param g The input graph.
+     * @param labels Output array of size V; labels[v] receives the component of v.
+     * @param numThreads Number of threads.
+     * @return int The number of components.
+     */
+    int Algorithms::connectedComponents(Graph& g, int* labels, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        int* roots = new int[V];
+
+        if (numThreads <= 1) {
+            UnionFind uf(V);
+            Node** adjList = g.getAdjList();
+            for (int u = 0; u < V; u++) {
+                for (Node* n = adjList[u]; n != nullptr; n = n->next) {
+                    uf.unite(u, n->vertex);
+                    STAT_ADD(edgesScanned, 1);
+                }
+            }
+            for (int v = 0; v < V; v++) {
+                roots[v] = uf.find(v);
+            }
+            STAT_ADD(findSteps, uf.getFindSteps());
+        }
+        else {
+            CSRGraph out(g);
+            CSRGraph in(g, true);
+            long long* outOff = out.getOffsets();
+            int* outTargets = out.getTargets();
+            long long* inOff = in.getOffsets();
+            int* inTargets = in.getTargets();
+            ConcurrentUnionFind cuf(V);
+            const int neighborRounds = 2;
+
+            // phase 1: link each vertex with its first few neighbors
+            for (int r = 0; r < neighborRounds; r++) {
+                parallelFor(V, numThreads, [&](int begin, int end, int) {
+                    for (int v = begin; v < end; v++) {
+                        if (outOff[v] + r < outOff[v + 1]) cuf.unite(v, outTargets[outOff[v] + r]);
+                    }
+                });
+            }
+
+            // phase 2: sample vertices to guess the largest intermediate component
+            int giant = -1;
+            if (V > 0) {
+                const int samples = 1024;
+                int* sampled = new int[samples];
+                unsigned long long x = 0x9E3779B97F4A7C15ULL;
+                for (int i = 0; i < samples; i++) {
+                    x ^= x << 13;
+                    x ^= x >> 7;
+                    x ^= x << 17;
+                    sampled[i] = cuf.find((int)(x % (unsigned long long)V));
+                }
+                sortByKey(sampled, samples, [](int v) { return (long long)v; });
+                int bestCount = 0;
+                for (int i = 0, j = 0; i < samples; i = j) {
+                    while (j < samples && sampled[j] == sampled[i]) j++;
+                    if (j - i > bestCount) {
+                        bestCount = j - i;
+                        giant = sampled[i];
+                    }
+                }
+                delete[] sampled;
+            }
+
+            // phase 3: vertices outside the giant component finish their remaining arcs;
+            // incoming arcs cover the edges whose source was skipped
+            parallelFor(V, numThreads, [&](int begin, int end, int) {
+                for (int v = begin; v < end; v++) {
+                    if (cuf.find(v) == giant) continue;
+                    for (long long i = outOff[v] + neighborRounds; i < outOff[v + 1]; i++) {
+                        cuf.unite(v, outTargets[i]);
+                    }
+                    for (long long i = inOff[v]; i < inOff[v + 1]; i++) {
+                        cuf.unite(v, inTargets[i]);
+                    }
+                }
+            });
+            STAT_ADD(edgesScanned, out.getNumArcs());
+
+            parallelFor(V, numThreads, [&](int begin, int end, int) {
+                for (int v = begin; v < end; v++) roots[v] = cuf.find(v);
+            });
+        }
+
+        int count = compactLabels(roots, V, labels);
+        STAT_ADD(verticesSettled, V);
+
+        delete[] roots;
+        return count;
+    }
+
+
+// ============================
+//   STRONG COMPONENTS SECTION
+// ============================
+    /**
+     * @brief Finds the strongly connected components of a directed graph and builds its condensation.
+     *        One thread: Tarjan's algorithm with an explicit call stack (vertex + next arc position),
+     *        so arbitrarily long paths cannot overflow the native stack.
+     *        More threads: the Multistep scheme. Trimming removes trivial SCCs, one forward-backward
+     *        search from the busiest vertex removes the giant SCC, and the coloring algorithm handles
+     *        the rest: colors (max vertex id) are propagated forward in parallel rounds, every vertex
+     *        that kept its own color is a root, and a backward search from it inside its color class
+     *        is exactly its SCC. Found SCCs are removed and the process repeats on the rest.
+     *        Component ids are compact and ordered by the smallest vertex of each component.
+     * 
+     * @param g The input graph (directed; an undirected edge is a pair of opposite arcs).
+     * @param componentIds Output array of size V; componentIds[v] receives the SCC of v.
+     * @param numThreads Number of threads.
+     * @return Graph The condensed DAG: one vertex per SCC and one arc per connected SCC pair,
+     *         weighted with the lightest original arc between them.
+     */
+    Graph Algorithms::stronglyConnectedComponents(Graph& g, int* componentIds, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph out(g);
+        long long* outOff = out.getOffsets();
+        int* outTargets = out.getTargets();
+        int* outWeights = out.getWeights();
+        int* raw = new int[V]; // representative vertex of the SCC of each vertex
+        STAT_ADD(edgesScanned, out.getNumArcs());
+
+        if (numThreads <= 1) {
+            int* index = new int[V];
+            int* low = new int[V];
+            bool* onStack = new bool[V];
+            int* callVertex = new int[V];
+            long long* callArc = new long long[V];
+            for (int v = 0; v < V; v++) {
+                index[v] = -1;
+                onStack[v] = false;
+            }
+            Stack sccStack;
+            int nextIndex = 0;
+
+            for (int root = 0; root < V; root++) {
+                if (index[root] != -1) continue;
+                int depth = 0;
+                callVertex[0] = root;
+                callArc[0] = outOff[root];
+                index[root] = low[root] = nextIndex++;
+                sccStack.push(root);
+                onStack[root] = true;
+
+                while (depth >= 0) {
+                    int u = callVertex[depth];
+                    if (callArc[depth] < outOff[u + 1]) {
+                        int v = outTargets[callArc[depth]++];
+                        if (index[v] == -1) { // descend into v
+                            index[v] = low[v] = nextIndex++;
+                            sccStack.push(v);
+                            onStack[v] = true;
+                            depth++;
+                            callVertex[depth] = v;
+                            callArc[depth] = outOff[v];
+                        } else if (onStack[v] && index[v] < low[u]) {
+                            low[u] = index[v];
+                        }
+                        continue;
+                    }
+                    // all arcs of u done: pop u, emit its SCC if it is a root
+                    STAT_ADD(verticesSettled, 1);
+                    if (low[u] == index[u]) {
+                        int w;
+                        do {
+                            w = sccStack.pop();
+                            onStack[w] = false;
+                            raw[w] = u;
+                        } while (w != u);
+                    }
+                    depth--;
+                    if (depth >= 0) {
+                        int parent = callVertex[depth];
+                        if (low[u] < low[parent]) low[parent] = low[u];
+                    }
+                }
+            }
+            delete[] index;
+            delete[] low;
+            delete[] onStack;
+            delete[] callVertex;
+            delete[] callArc;
+        }
+        else {
+            CSRGraph in(g, true);
+            long long* inOff = in.getOffsets();
+            int* inTargets = in.getTargets();
+            std::atomic<int>* color = new std::atomic<int>[V];
+            bool* done = new bool[V];
+            int* active = new int[V];      // vertices not yet assigned, compacted every round
+            int* nextActive = new int[V];
+            int activeCount = V;
+            for (int v = 0; v < V; v++) {
+                done[v] = false;
+                active[v] = v;
+                raw[v] = -1;
+            }
+            int** queues = new int*[numThreads]; // per-thread backward search queues
+            for (int t = 0; t < numThreads; t++) {
+                queues[t] = new int[V];
+            }
+
+            while (activeCount > 0) {
+                // trim: a vertex without live incoming or outgoing arcs is an SCC by itself
+                parallelFor(activeCount, numThreads, [&](int begin, int end, int) {
+                    for (int i = begin; i < end; i++) {
+                        int v = active[i];
+                        bool hasIn = false, hasOut = false;
+                        for (long long e = outOff[v]; e < outOff[v + 1] && !hasOut; e++) {
+                            hasOut = !done[outTargets[e]] && outTargets[e] != v;
+                        }
+                        for (long long e = inOff[v]; e < inOff[v + 1] && !hasIn; e++) {
+                            hasIn = !done[inTargets[e]] && inTargets[e] != v;
+                        }
+                        color[v].store((hasIn && hasOut) ? v : -1, std::memory_order_relaxed);
+                    }
+                });
+                for (int i = 0; i < activeCount; i++) {
+                    int v = active[i];
+                    if (color[v].load(std::memory_order_relaxed) == -1) {
+                        raw[v] = v;
+                        done[v] = true;
+                    }
+                }
+
+                // first round only: forward-backward from the busiest vertex peels the giant SCC,
+                // which coloring alone would need one round per unit of diameter to settle
+                if (activeCount == V) {
+                    int pivot = -1;
+                    long long best = -1;
+                    for (int v = 0; v < V; v++) {
+                        long long weight = (outOff[v + 1] - outOff[v]) * (inOff[v + 1] - inOff[v]);
+                        if (!done[v] && weight > best) {
+                            best = weight;
+                            pivot = v;
+                        }
+                    }
+                    if (pivot != -1) {
+                        bool* reached = new bool[V];
+                        for (int v = 0; v < V; v++) reached[v] = false;
+                        int* queue = queues[0];
+                        int head = 0, tail = 0;
+                        queue[tail++] = pivot;
+                        reached[pivot] = true;
+                        while (head < tail) {
+                            int v = queue[head++];
+                            for (long long e = outOff[v]; e < outOff[v + 1]; e++) {
+                                int u = outTargets[e];
+                                if (done[u] || reached[u]) continue;
+                                reached[u] = true;
+                                queue[tail++] = u;
+                            }
+                        }
+                        head = tail = 0;
+                        queue[tail++] = pivot;
+                        raw[pivot] = pivot;
+                        while (head < tail) {
+                            int v = queue[head++];
+                            for (long long e = inOff[v]; e < inOff[v + 1]; e++) {
+                                int u = inTargets[e];
+                                if (done[u] || !reached[u] || raw[u] == pivot) continue;
+                                raw[u] = pivot;
+                                queue[tail++] = u;
+                            }
+                        }
+                        for (int i = 0; i < tail; i++) {
+                            done[queue[i]] = true;
+                        }
+                        delete[] reached;
+                    }
+                }
+
+                // forward coloring: push the largest color along live arcs until stable
+                std::atomic<bool> changed(true);
+                while (changed.load()) {
+                    changed.store(false);
+                    parallelFor(activeCount, numThreads, [&](int begin, int end, int) {
+                        bool local = false;
+                        for (int i = begin; i < end; i++) {
+                            int v = active[i];
+                            if (done[v]) continue;
+                            int c = color[v].load(std::memory_order_relaxed);
+                            for (long long e = outOff[v]; e < outOff[v + 1]; e++) {
+                                int u = outTargets[e];
+                                if (done[u]) continue;
+                                int cu = color[u].load(std::memory_order_relaxed);
+                                while (cu < c && !color[u].compare_exchange_weak(cu, c, std::memory_order_relaxed)) {}
+                                if (cu < c) local = true;
+                            }
+                        }
+                        if (local) changed.store(true);
+                    });
+                }
+
+                // backward search from every root inside its color class
+                parallelFor(activeCount, numThreads, [&](int begin, int end, int t) {
+                    int* queue = queues[t];
+                    for (int i = begin; i < end; i++) {
+                        int r = active[i];
+                        if (done[r] || color[r].load(std::memory_order_relaxed) != r) continue;
+                        int head = 0, tail = 0;
+                        queue[tail++] = r;
+                        raw[r] = r;
+                        while (head < tail) {
+                            int v = queue[head++];
+                            for (long long e = inOff[v]; e < inOff[v + 1]; e++) {
+                                int u = inTargets[e];
+                                if (done[u] || color[u].load(std::memory_order_relaxed) != r || raw[u] == r) continue;
+                                raw[u] = r;
+                                queue[tail++] = u;
+                            }
+                        }
+                    }
+                });
+
+                // drop every vertex whose SCC was found this round
+                int kept = 0;
+                for (int i = 0; i < activeCount; i++) {
+                    int v = active[i];
+                    if (done[v]) continue;
+                    int c = color[v].load(std::memory_order_relaxed);
+                    if (raw[v] == c && c >= 0) {
+                        done[v] = true;
+                    } else {
+                        nextActive[kept++] = v;
+                    }
+                }
+                STAT_ADD(verticesSettled, activeCount - kept);
+                int* temp = active;
+                active = nextActive;
+                nextActive = temp;
+                activeCount = kept;
+            }
+
+            for (int t = 0; t < numThreads; t++) {
+                delete[] queues[t];
+            }
+            delete[] queues;
+            delete[] color;
+            delete[] done;
+            delete[] active;
+            delete[] nextActive;
+        }
+
+        int count = compactLabels(raw, V, componentIds);
+
+        // condensation: group vertices by component, keep the lightest arc per component pair
+        int* memberOff = new int[count + 1];
+        int* members = new int[V];
+        for (int c = 0; c <= count; c++) memberOff[c] = 0;
+        for (int v = 0; v < V; v++) memberOff[componentIds[v] + 1]++;
+        for (int c = 0; c < count; c++) memberOff[c + 1] += memberOff[c];
+        int* cursor = new int[count];
+        for (int c = 0; c < count; c++) cursor[c] = memberOff[c];
+        for (int v = 0; v < V; v++) members[cursor[componentIds[v]]++] = v;
+
+        Graph dag(count);
+        int* seenBy = new int[count];
+        int* lightest = new int[count];
+        int* touched = new int[count];
+        for (int c = 0; c < count; c++) seenBy[c] = -1;
+        for (int c = 0; c < count; c++) {
+            int numTouched = 0;
+            for (int m = memberOff[c]; m < memberOff[c + 1]; m++) {
+                int u = members[m];
+                for (long long e = outOff[u]; e < outOff[u + 1]; e++) {
+                    int d = componentIds[outTargets[e]];
+                    if (d == c) continue;
+                    if (seenBy[d] != c) {
+                        seenBy[d] = c;
+                        lightest[d] = outWeights[e];
+                        touched[numTouched++] = d;
+                    } else if (outWeights[e] < lightest[d]) {
+                        lightest[d] = outWeights[e];
+                    }
+                }
+            }
+            for (int i = numTouched - 1; i >= 0; i--) {
+                dag.addDirectedEdge(c, touched[i], lightest[touched[i]]);
+            }
+        }
+
+        delete[] raw;
+        delete[] memberOff;
+        delete[] members;
+        delete[] cursor;
+        delete[] seenBy;
+        delete[] lightest;
+        delete[] touched;
+        return dag;
+    }
+
+
+// ============================
+//    MULTI-SOURCE BFS SECTION
+// ============================
+    /**
+     * @brief Computes BFS hop distances from many sources at once (MS-BFS).
+     *        Sources are processed in batches of 64: every vertex keeps a 64-bit mask of the batch
+     *        sources that have seen it and of those that reach it in the current level, so one scan
+     *        of a frontier vertex's arcs advances all of its searches together with a few word ORs.
+     *        Batches are independent and run in parallel.
+     * 
+     * @param g The graph.
+     * @param sources The source vertices (duplicates allowed).
+     * @param numSources Number of sources.
+     * @param distances Output array of size numSources * V: distances[i * V + v] is the hop count
+     *        from sources[i] to v, or -1 if v is unreachable.
+     * @param numThreads Number of threads (each works on whole batches).
+     */
+    void Algorithms::multiSourceBfs(Graph& g, const int* sources, int numSources, int* distances, int numThreads) {
+        int V = g.getNumVertices();
+        if (numSources < 0) {
+            throw std::invalid_argument("Number of sources must not be negative.");
+        }
+        for (int i = 0; i < numSources; i++) {
+            if (sources[i] < 0 || sources[i] >= V) {
+                throw std::out_of_range("Vertex index out of range.");
+            }
+        }
+        STAT_RESET();
+        if (numThreads < 1) numThreads = 1;
+        for (long long i = 0; i < (long long)numSources * V; i++) {
+            distances[i] = -1;
+        }
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+
+        const int lanes = 64;
+        int batches = (numSources + lanes - 1) / lanes;
+        if (numThreads > batches) numThreads = batches > 0 ? batches : 1;
+        unsigned long long** seenOf = new unsigned long long*[numThreads];
+        unsigned long long** visitOf = new unsigned long long*[numThreads];
+        unsigned long long** nextOf = new unsigned long long*[numThreads];
+        int** frontierOf = new int*[numThreads];
+        int** nextFrontierOf = new int*[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            seenOf[t] = new unsigned long long[V];
+            visitOf[t] = new unsigned long long[V];
+            nextOf[t] = new unsigned long long[V];
+            frontierOf[t] = new int[V];
+            nextFrontierOf[t] = new int[V];
+        }
+        long long* settled = new long long[batches];
+        long long* scanned = new long long[batches];
+        int* peak = new int[batches];
+
+        parallelFor(batches, numThreads, [&](int begin, int end, int t) {
+            unsigned long long* seen = seenOf[t];
+            unsigned long long* visit = visitOf[t];
+            unsigned long long* next = nextOf[t];
+            int* frontier = frontierOf[t];
+            int* nextFrontier = nextFrontierOf[t];
+            for (int b = begin; b < end; b++) {
+                int first = b * lanes;
+                int count = numSources - first < lanes ? numSources - first : lanes;
+                for (int v = 0; v < V; v++) {
+                    seen[v] = 0;
+                    visit[v] = 0;
+                    next[v] = 0;
+                }
+                int frontierSize = 0;
+                for (int i = 0; i < count; i++) {
+                    int s = sources[first + i];
+                    if (visit[s] == 0) frontier[frontierSize++] = s;
+                    visit[s] |= 1ULL << i;
+                    seen[s] |= 1ULL << i;
+                    distances[(long long)(first + i) * V + s] = 0;
+                }
+                settled[b] = 0;
+                scanned[b] = 0;
+                peak[b] = frontierSize;
+
+                for (int level = 1; frontierSize > 0; level++) {
+                    int nextSize = 0;
+                    for (int f = 0; f < frontierSize; f++) {
+                        int v = frontier[f];
+                        unsigned long long mask = visit[v];
+                        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                            int u = targets[e];
+                            unsigned long long reach = mask & ~seen[u];
+                            if (reach == 0) continue;
+                            if (next[u] == 0) nextFrontier[nextSize++] = u;
+                            next[u] |= reach;
+                        }
+                        scanned[b] += offsets[v + 1] - offsets[v];
+                        visit[v] = 0;
+                    }
+                    settled[b] += frontierSize;
+
+                    for (int f = 0; f < nextSize; f++) {
+                        int u = nextFrontier[f];
+                        unsigned long long bits = next[u];
+                        seen[u] |= bits;
+                        while (bits != 0) {
+                            int i = __builtin_ctzll(bits);
+                            distances[(long long)(first + i) * V + u] = level;
+                            bits &= bits - 1;
+                        }
+                    }
+
+                    unsigned long long* tempMasks = visit;
+                    visit = next;
+                    next = tempMasks;
+                    int* tempFrontier = frontier;
+                    frontier = nextFrontier;
+                    nextFrontier = tempFrontier;
+                    frontierSize = nextSize;
+                    if (frontierSize > peak[b]) peak[b] = frontierSize;
+                }
+            }
+        }, 1);
+
+        for (int b = 0; b < batches; b++) {
+            STAT_ADD(verticesSettled, settled[b]);
+            STAT_ADD(edgesScanned, scanned[b]);
+            STAT_PEAK(queuePeak, peak[b]);
+        }
+        for (int t = 0; t < numThreads; t++) {
+            delete[] seenOf[t];
+            delete[] visitOf[t];
+            delete[] nextOf[t];
+            delete[] frontierOf[t];
+            delete[] nextFrontierOf[t];
+        }
+        delete[] seenOf;
+        delete[] visitOf;
+        delete[] nextOf;
+        delete[] frontierOf;
+        delete[] nextFrontierOf;
+        delete[] settled;
+        delete[] scanned;
+        delete[] peak;
+    }
+
+
+// ============================
+//   ALL-PAIRS SHORTEST PATHS
+// ============================
+    /**
+     * @brief Computes all-pairs shortest path distances with a cache-blocked Floyd-Warshall.
+     *        The graph is copied into a V x V matrix (lightest arc per pair), then processed in
+     *        64 x 64 tiles: for each diagonal tile, first the tile itself, then its row and column
+     *        tiles, then all remaining tiles in parallel. Meant for small dense graphs (O(V^3) time).
+     *        Negative arc weights are allowed; distances are assumed to stay within +-2^29.
+     * 
+     * @param g The graph.
+     * @param distances Output array of size V * V: distances[u * V + v] is the distance from u to v,
+     *        or 2147483647 if v is unreachable from u.
+     * @param numThreads Number of threads.
+     * 
+     * @throws std::invalid_argument If the graph has a negative cycle.
+     */
+    void Algorithms::floydWarshall(Graph& g, int* distances, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        const int inf = 1073741823; // half of INT_MAX, so inf + inf does not overflow
+        for (long long i = 0; i < (long long)V * V; i++) {
+            distances[i] = inf;
+        }
+        for (int v = 0; v < V; v++) {
+            distances[(long long)v * V + v] = 0;
+        }
+        Node** adjList = g.getAdjList();
+        for (int u = 0; u < V; u++) {
+            for (Node* n = adjList[u]; n != nullptr; n = n->next) {
+                int& cell = distances[(long long)u * V + n->vertex];
+                if (n->weight < cell) cell = n->weight;
+                STAT_ADD(edgesScanned, 1);
+            }
+        }
+
+        const int tile = 64;
+        int tiles = (V + tile - 1) / tile;
+        for (int kb = 0; kb < tiles; kb++) {
+            int k0 = kb * tile, k1 = k0 + tile < V ? k0 + tile : V;
+            minPlusTile<tile>(distances, V, k0, k1, k0, k1, k0, k1, inf);
+
+            // tiles in the pivot row (t < tiles) and the pivot column (t >= tiles)
+            parallelFor(2 * tiles, numThreads, [&](int begin, int end, int) {
+                for (int t = begin; t < end; t++) {
+                    int b = t < tiles ? t : t - tiles;
+                    if (b == kb) continue;
+                    int b0 = b * tile, b1 = b0 + tile < V ? b0 + tile : V;
+                    if (t < tiles) minPlusTile<tile>(distances, V, k0, k1, b0, b1, k0, k1, inf);
+                    else minPlusTile<tile>(distances, V, b0, b1, k0, k1, k0, k1, inf);
+                }
+            }, 1);
+
+            // every other tile depends only on the pivot row and column
+            parallelFor(tiles * tiles, numThreads, [&](int begin, int end, int) {
+                for (int t = begin; t < end; t++) {
+                    int ib = t / tiles, jb = t % tiles;
+                    if (ib == kb || jb == kb) continue;
+                    int i0 = ib * tile, i1 = i0 + tile < V ? i0 + tile : V;
+                    int j0 = jb * tile, j1 = j0 + tile < V ? j0 + tile : V;
+                    minPlusTile<tile>(distances, V, i0, i1, j0, j1, k0, k1, inf);
+                }
+            }, 4);
+            STAT_ADD(verticesSettled, k1 - k0);
+        }
+
+        for (int v = 0; v < V; v++) {
+            if (distances[(long long)v * V + v] < 0) {
+                throw std::invalid_argument("Graph contains a negative cycle.");
+            }
+        }
+        // an unreachable entry may have drifted below inf through negative arcs, never below inf / 2
+        for (long long i = 0; i < (long long)V * V; i++) {
+            if (distances[i] > inf / 2) distances[i] = 2147483647;
+        }
+    }
+
+    /**
+     * @brief Computes all-pairs shortest path distances by running Dijkstra from every source.
+     *        Sources are split between the threads, each with its own heap and visited array,
+     *        over a shared CSR snapshot. Better than Floyd-Warshall on sparse graphs (O(V * E log E)).
+     * 
+     * @param g The graph (non-negative weights).
+     * @param distances Output array of size V * V: distances[u * V + v] is the distance from u to v,
+     *        or 2147483647 if v is unreachable from u.
+     * @param numThreads Number of threads.
+     * 
+     * @throws std::invalid_argument If the graph has a negative arc weight.
+     */
+    void Algorithms::allPairsDijkstra(Graph& g, int* distances, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        for (long long e = 0; e < csr.getNumArcs(); e++) {
+            if (weights[e] < 0) {
+                throw std::invalid_argument("Dijkstra requires non-negative weights.");
+            }
+        }
+
+        dijkstraAllSources(V, offsets, targets, weights, distances, numThreads);
+    }
+
+
+// ============================
+//   NEGATIVE WEIGHTS SECTION
+// ============================
+    /**
+     * @brief Computes single-source shortest paths with arbitrary (also negative) arc weights.
+     *        Bellman-Ford driven by a FIFO queue (SPFA), so only vertices whose distance dropped are rescanned;
+     *        the worst case stays O(V * E). Note that an undirected negative edge is itself a negative cycle.
+     * 
+     * @param g The graph.
+     * @param start The source vertex.
+     * @param distances Output array of size V, 2147483647 for unreachable vertices.
+     * @param parent Optional output array of size V with each vertex's predecessor (-1 for none).
+     * @return true If no negative cycle is reachable from start; false otherwise (distances are then partial).
+     * 
+     * @throws std::out_of_range If the start vertex is not within the valid range.
+     */
+    bool Algorithms::bellmanFord(Graph& g, int start, int* distances, int* parent) {
+        int V = g.getNumVertices();
+        if (start < 0 || start >= V) {
+            throw std::out_of_range("Invalid start vertex in BELLMAN-FORD");
+        }
+        STAT_RESET();
+        CSRGraph csr(g);
+        for (int v = 0; v < V; v++) {
+            distances[v] = 2147483647;
+            if (parent != nullptr) parent[v] = -1;
+        }
+        distances[start] = 0;
+        return shortestPathFaster(V, csr.getOffsets(), csr.getTargets(), csr.getWeights(), distances, parent, start);
+    }
+
+    /**
+     * @brief Computes all-pairs shortest path distances on a sparse graph with negative arc weights.
+     *        SPFA from a virtual source gives potentials h; reweighting every arc to w + h[u] - h[v]
+     *        makes all weights non-negative without changing shortest paths, so Dijkstra runs from
+     *        every source (in parallel), and the potentials are subtracted back out.
+     * 
+     * @param g The graph.
+     * @param distances Output array of size V * V: distances[u * V + v] is the distance from u to v,
+     *        or 2147483647 if v is unreachable from u.
+     * @param numThreads Number of threads for the Dijkstra phase.
+     * 
+     * @throws std::invalid_argument If the graph has a negative cycle.
+     */
+    void Algorithms::johnson(Graph& g, int* distances, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+
+        int* potential = new int[V];
+        for (int v = 0; v < V; v++) {
+            potential[v] = 0;
+        }
+        if (!shortestPathFaster(V, offsets, targets, weights, potential, nullptr, -1)) {
+            delete[] potential;
+            throw std::invalid_argument("Graph contains a negative cycle.");
+        }
+
+        int* reweighted = new int[offsets[V] > 0 ? offsets[V] : 1];
+        for (int u = 0; u < V; u++) {
+            for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                reweighted[e] = weights[e] + potential[u] - potential[targets[e]];
+            }
+        }
+        dijkstraAllSources(V, offsets, targets, reweighted, distances, numThreads);
+
+        parallelFor(V, numThreads, [&](int begin, int end, int) {
+            for (int u = begin; u < end; u++) {
+                int* row = distances + (long long)u * V;
+                for (int v = 0; v < V; v++) {
+                    if (row[v] != 2147483647) row[v] = row[v] - potential[u] + potential[v];
+                }
+            }
+        });
+        delete[] reweighted;
+        delete[] potential;
+    }
+
+
+// ============================
+//        PAGERANK SECTION
+// ============================
+    /**
+     * @brief Computes PageRank by pull-based power iteration.
+     *        Every round each vertex sums contrib[u] = rank[u] / outdeg(u) over its in-arcs (a row of the
+     *        transposed CSR), so there are no write conflicts; dangling vertices spread their rank evenly.
+     *        Threads own contiguous vertex ranges holding about the same number of in-arcs.
+     *        Stops when the L1 change of the rank vector drops below tolerance.
+     * 
+     * @param g The graph (parallel arcs count with multiplicity).
+     * @param ranks Output array of size V; the ranks sum to 1.
+     * @param damping Probability of following an arc (1 - damping is the teleport probability).
+     * @param tolerance Convergence threshold on the L1 change per iteration.
+     * @param maxIterations Upper bound on the number of iterations.
+     * @param numThreads Number of threads.
+     * @return int The number of iterations run.
+     * 
+     * @throws std::invalid_argument If damping is outside [0, 1] or maxIterations is negative.
+     */
+    int Algorithms::pagerank(Graph& g, double* ranks, double damping, double tolerance, int maxIterations, int numThreads) {
+        if (damping < 0.0 || damping > 1.0 || maxIterations < 0) {
+            throw std::invalid_argument("Invalid PageRank parameters.");
+        }
+        STAT_RESET();
+        int V = g.getNumVertices();
+        if (V == 0) return 0;
+        if (numThreads < 1) numThreads = 1;
+        CSRGraph out(g);
+        CSRGraph in(g, true);
+        long long* outOff = out.getOffsets();
+        long long* inOff = in.getOffsets();
+        int* inSources = in.getTargets();
+
+        // partition p owns [bounds[p], bounds[p + 1]), cut where the in-arc prefix crosses p / numThreads
+        int* bounds = new int[numThreads + 1];
+        bounds[0] = 0;
+        for (int p = 1; p < numThreads; p++) {
+            long long goal = (inOff[V] + V) * p / numThreads; // vertices weigh one unit too
+            int lo = bounds[p - 1], hi = V;
+            while (lo < hi) {
+                int mid = lo + (hi - lo) / 2;
+                if (inOff[mid] + mid < goal) lo = mid + 1;
+                else hi = mid;
+            }
+            bounds[p] = lo;
+        }
+        bounds[numThreads] = V;
+
+        double* contrib = new double[V];
+        double* buffer = new double[V];
+        double* current = ranks; // the two rank vectors swap roles every iteration
+        double* next = buffer;
+        double* partDelta = new double[numThreads];
+        double* partDangling = new double[numThreads];
+        for (int v = 0; v < V; v++) {
+            ranks[v] = 1.0 / V;
+        }
+
+        int iteration = 0;
+        double delta = tolerance + 1.0;
+        while (iteration < maxIterations && delta >= tolerance) {
+            parallelFor(numThreads, numThreads, [&](int begin, int end, int) {
+                for (int p = begin; p < end; p++) {
+                    double dangling = 0.0;
+                    for (int u = bounds[p]; u < bounds[p + 1]; u++) {
+                        long long degree = outOff[u + 1] - outOff[u];
+                        if (degree == 0) dangling += current[u];
+                        contrib[u] = degree == 0 ? 0.0 : current[u] / degree;
+                    }
+                    partDangling[p] = dangling;
+                }
+            }, 1);
+            double dangling = 0.0;
+            for (int p = 0; p < numThreads; p++) dangling += partDangling[p];
+            double base = (1.0 - damping) / V + damping * dangling / V;
+
+            parallelFor(numThreads, numThreads, [&](int begin, int end, int) {
+                for (int p = begin; p < end; p++) {
+                    double change = 0.0;
+                    for (int v = bounds[p]; v < bounds[p + 1]; v++) {
+                        double sum = 0.0;
+                        for (long long e = inOff[v]; e < inOff[v + 1]; e++) {
+                            sum += contrib[inSources[e]];
+                        }
+                        next[v] = base + damping * sum;
+                        double diff = next[v] - current[v];
+                        change += diff < 0.0 ? -diff : diff;
+                    }
+                    partDelta[p] = change;
+                }
+            }, 1);
+            delta = 0.0;
+            for (int p = 0; p < numThreads; p++) delta += partDelta[p];
+
+            double* temp = current;
+            current = next;
+            next = temp;
+            iteration++;
+            STAT_ADD(verticesSettled, V);
+            STAT_ADD(edgesScanned, inOff[V]);
+        }
+
+        if (current != ranks) {
+            for (int v = 0; v < V; v++) ranks[v] = current[v];
+        }
+        delete[] bounds;
+        delete[] contrib;
+        delete[] buffer;
+        delete[] partDelta;
+        delete[] partDangling;
+        return iteration;
+    }
+
+
+// ============================
+//         K-CORE SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Batagelj-Zaversnik peeling, O(V + E). Vertices sit in an array bucket-sorted by current
+     *        degree; peeling the lowest vertex moves each higher neighbor one bucket down in O(1).
+     * 
+     * @param cores Output array of size V with the core numbers.
+     * @param order Output array of size V with the peeling order (a smallest-last vertex ordering).
+     */
+    void peelByDegree(int V, long long* offsets, int* targets, int* cores, int* order) {
+        int maxDegree = 0;
+        for (int v = 0; v < V; v++) {
+            cores[v] = (int)(offsets[v + 1] - offsets[v]); // current degree, final core number once peeled
+            if (cores[v] > maxDegree) maxDegree = cores[v];
+        }
+        int* binStart = new int[maxDegree + 2];
+        int* position = new int[V]; // position[v]: index of v in order
+        for (int d = 0; d <= maxDegree + 1; d++) binStart[d] = 0;
+        for (int v = 0; v < V; v++) binStart[cores[v] + 1]++;
+        for (int d = 0; d <= maxDegree; d++) binStart[d + 1] += binStart[d];
+        for (int v = 0; v < V; v++) {
+            position[v] = binStart[cores[v]]++;
+            order[position[v]] = v;
+        }
+        for (int d = maxDegree; d > 0; d--) binStart[d] = binStart[d - 1];
+        binStart[0] = 0;
+
+        for (int i = 0; i < V; i++) {
+            int v = order[i];
+            STAT_ADD(edgesScanned, offsets[v + 1] - offsets[v]);
+            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                int u = targets[e];
+                if (cores[u] <= cores[v]) continue;
+                // swap u with the first vertex of its bucket, then shrink the bucket past it
+                int du = cores[u];
+                int first = order[binStart[du]];
+                if (first != u) {
+                    order[position[u]] = first;
+                    position[first] = position[u];
+                    order[binStart[du]] = u;
+                    position[u] = binStart[du];
+                }
+                binStart[du]++;
+                cores[u]--;
+            }
+        }
+        delete[] binStart;
+        delete[] position;
+    }
+
+}
+    /**
+     * @brief Computes the core number of every vertex: the largest k such that the vertex belongs to a
+     *        subgraph in which every vertex has degree at least k. The graph is taken as undirected, and
+     *        degrees count adjacency entries (parallel edges with multiplicity).
+     *        One thread: Batagelj-Zaversnik, O(V + E).
+     *        More threads: level-synchronous peeling. For k = 0, 1, ... every vertex of degree <= k gets core
+     *        number k; its removal decrements neighbor degrees atomically, and a neighbor dropping to k
+     *        joins the same level, until the level runs dry.
+     * 
+     * @param g The graph.
+     * @param cores Output array of size V with the core numbers.
+     * @param numThreads Number of threads.
+     * @return int The largest core number (the degeneracy of the graph), 0 for an empty graph.
+     */
+    int Algorithms::coreNumbers(Graph& g, int* cores, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        if (V == 0) return 0;
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int maxCore = 0;
+
+        if (numThreads <= 1) {
+            int* order = new int[V];
+            peelByDegree(V, offsets, targets, cores, order);
+            for (int v = 0; v < V; v++) {
+                if (cores[v] > maxCore) maxCore = cores[v];
+            }
+            delete[] order;
+        }
+        else {
+            std::atomic<int>* degree = new std::atomic<int>[V];
+            bool* peeled = new bool[V];
+            int* active = new int[V];  // vertices not yet peeled
+            int* frontier = new int[V];
+            int* nextFrontier = new int[V];
+            int activeCount = V;
+            for (int v = 0; v < V; v++) {
+                degree[v].store((int)(offsets[v + 1] - offsets[v]), std::memory_order_relaxed);
+                peeled[v] = false;
+                active[v] = v;
+            }
+
+            int k = 0;
+            while (activeCount > 0) {
+                std::atomic<int> size(0);
+                parallelFor(activeCount, numThreads, [&](int begin, int end, int) {
+                    for (int i = begin; i < end; i++) {
+                        int v = active[i];
+                        if (degree[v].load(std::memory_order_relaxed) <= k) frontier[size.fetch_add(1)] = v;
+                    }
+                });
+                int frontierSize = size.load();
+                while (frontierSize > 0) {
+                    for (int i = 0; i < frontierSize; i++) {
+                        cores[frontier[i]] = k;
+                        peeled[frontier[i]] = true;
+                    }
+                    // long chains peel a few vertices per round; threads only pay off on wide frontiers
+                    int roundThreads = frontierSize < 1024 ? 1 : numThreads;
+                    std::atomic<int> nextSize(0);
+                    parallelFor(frontierSize, roundThreads, [&](int begin, int end, int) {
+                        for (int i = begin; i < end; i++) {
+                            int v = frontier[i];
+                            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                                int u = targets[e];
+                                if (peeled[u]) continue;
+                                // exactly one decrement crosses from k + 1 to k
+                                if (degree[u].fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                                    nextFrontier[nextSize.fetch_add(1)] = u;
+                                }
+                            }
+                        }
+                    });
+                    for (int i = 0; i < frontierSize; i++) {
+                        STAT_ADD(edgesScanned, offsets[frontier[i] + 1] - offsets[frontier[i]]);
+                    }
+                    int* temp = frontier;
+                    frontier = nextFrontier;
+                    nextFrontier = temp;
+                    frontierSize = nextSize.load();
+                }
+
+                // drop peeled vertices; the next level is the smallest remaining degree
+                int kept = 0;
+                int lowest = 2147483647;
+                for (int i = 0; i < activeCount; i++) {
+                    int v = active[i];
+                    if (peeled[v]) continue;
+                    active[kept++] = v;
+                    int d = degree[v].load(std::memory_order_relaxed);
+                    if (d < lowest) lowest = d;
+                }
+                if (kept < activeCount) maxCore = k;
+                activeCount = kept;
+                k = lowest > k + 1 ? lowest : k + 1;
+            }
+            delete[] degree;
+            delete[] peeled;
+            delete[] active;
+            delete[] frontier;
+            delete[] nextFrontier;
+        }
+        STAT_ADD(verticesSettled, V);
+        return maxCore;
+    }
+
+
+// ============================
+//      BETWEENNESS SECTION
+// ============================
+    /**
+     * @brief Computes betweenness centrality with Brandes' algorithm: c(v) = sum over ordered pairs
+     *        (s, t), s != v != t, of the fraction of shortest s-t paths through v (so an undirected
+     *        pair counts twice). For each source a BFS (or Dijkstra) counts shortest paths sigma and
+     *        records the settle order; walking that order backwards accumulates the dependencies
+     *        delta(v) = sum over tight arcs v -> w of sigma(v) / sigma(w) * (1 + delta(w)).
+     *        Sources are split between threads, each with its own buffers and centrality array.
+     *        With samples > 0, that many sources are drawn uniformly (with replacement) and the sums
+     *        are scaled by V / samples, an unbiased estimate.
+     * 
+     * @param g The graph.
+     * @param centrality Output array of size V.
+     * @param weighted Use arc weights (must be positive) instead of hop counts.
+     * @param samples Number of sampled sources, or 0 for the exact result (every vertex is a source).
+     * @param numThreads Number of threads.
+     * @param seed Random seed for the sampled sources.
+     * @return double Error bound: with probability at least 0.95, every |estimate - c(v)| is at most
+     *         this value times V * (V - 2) (Hoeffding bound plus a union bound over the vertices). 0 when exact.
+     * 
+     * @throws std::invalid_argument If samples is negative, or weighted and some weight is not positive.
+     */
+    double Algorithms::betweenness(Graph& g, double* centrality, bool weighted, int samples, int numThreads,
+                                   unsigned long long seed) {
+        if (samples < 0) {
+            throw std::invalid_argument("Number of samples must not be negative.");
+        }
+        STAT_RESET();
+        int V = g.getNumVertices();
+        if (numThreads < 1) numThreads = 1;
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        if (weighted) {
+            for (long long e = 0; e < offsets[V]; e++) {
+                if (weights[e] <= 0) {
+                    throw std::invalid_argument("Weighted betweenness requires positive weights.");
+                }
+            }
+        }
+        for (int v = 0; v < V; v++) {
+            centrality[v] = 0.0;
+        }
+        if (V == 0) return 0.0;
+
+        int sourceCount = samples > 0 ? samples : V;
+        int* sources = new int[sourceCount];
+        unsigned long long x = seed * 0x9E3779B97F4A7C15ULL + 1;
+        for (int i = 0; i < sourceCount; i++) {
+            if (samples == 0) {
+                sources[i] = i;
+                continue;
+            }
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            sources[i] = (int)(x % (unsigned long long)V);
+        }
+
+        double** localOf = new double*[numThreads];
+        long long* settled = new long long[numThreads];
+        long long* scanned = new long long[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            localOf[t] = new double[V];
+            for (int v = 0; v < V; v++) localOf[t][v] = 0.0;
+            settled[t] = scanned[t] = 0;
+        }
+
+        parallelFor(sourceCount, numThreads, [&](int begin, int end, int t) {
+            double* local = localOf[t];
+            int* dist = new int[V];
+            double* sigma = new double[V];
+            double* delta = new double[V];
+            int* order = new int[V]; // vertices in the order they were settled
+            bool* done = new bool[V];  // Dijkstra settled flags
+            for (int v = 0; v < V; v++) {
+                dist[v] = -1;
+                done[v] = false;
+            }
+            Queue queue;
+            PriorityQueue pq(weighted ? (int)offsets[V] + 1 : 1);
+
+            for (int i = begin; i < end; i++) {
+                int s = sources[i];
+                int count = 0;
+                dist[s] = 0;
+                sigma[s] = 1.0;
+                if (!weighted) {
+                    queue.enqueue(s);
+                    while (!queue.isEmpty()) {
+                        int v = queue.dequeue();
+                        order[count++] = v;
+                        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                            int w = targets[e];
+                            if (dist[w] == -1) {
+                                dist[w] = dist[v] + 1;
+                                sigma[w] = 0.0;
+                                queue.enqueue(w);
+                            }
+                            if (dist[w] == dist[v] + 1) sigma[w] += sigma[v];
+                        }
+                    }
+                }
+                else {
+                    pq.insert(s, 0);
+                    while (!pq.isEmpty()) {
+                        int v = pq.extractMin();
+                        if (done[v]) continue;
+                        done[v] = true;
+                        order[count++] = v;
+                        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                            int w = targets[e];
+                            int through = dist[v] + weights[e];
+                            if (dist[w] == -1 || through < dist[w]) {
+                                dist[w] = through;
+                                sigma[w] = 0.0;
+                                pq.insert(w, through);
+                            }
+                            if (through == dist[w]) sigma[w] += sigma[v];
+                        }
+                    }
+                }
+                settled[t] += count;
+
+                for (int k = 0; k < count; k++) delta[order[k]] = 0.0;
+                for (int k = count - 1; k >= 0; k--) {
+                    int v = order[k];
+                    double sum = 0.0;
+                    for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                        int w = targets[e];
+                        int step = weighted ? weights[e] : 1;
+                        if (dist[w] == dist[v] + step) sum += (1.0 + delta[w]) / sigma[w];
+                    }
+                    delta[v] = sigma[v] * sum;
+                    if (v != s) local[v] += delta[v];
+                    scanned[t] += 2 * (offsets[v + 1] - offsets[v]);
+                }
+                for (int k = 0; k < count; k++) {
+                    dist[order[k]] = -1;
+                    done[order[k]] = false;
+                }
+            }
+            delete[] done;
+            delete[] dist;
+            delete[] sigma;
+            delete[] delta;
+            delete[] order;
+        }, 1);
+
+        double scale = samples > 0 ? (double)V / samples : 1.0;
+        for (int t = 0; t < numThreads; t++) {
+            for (int v = 0; v < V; v++) centrality[v] += localOf[t][v] * scale;
+            STAT_ADD(verticesSettled, settled[t]);
+            STAT_ADD(edgesScanned, scanned[t]);
+            delete[] localOf[t];
+        }
+        delete[] localOf;
+        delete[] settled;
+        delete[] scanned;
+        delete[] sources;
+        if (samples == 0) return 0.0;
+        return std::sqrt(std::log(2.0 * V / 0.05) / (2.0 * samples));
+    }
+
+
+// ============================
+//        MAX FLOW SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Residual network in flat arrays: the arcs of vertex v are [offsets[v], offsets[v + 1]),
+     *        and every arc e is paired with its reverse arc partner[e], so pushing flow on e is
+     *        cap[e] -= f, cap[partner[e]] += f. Each graph arc u -> v (capacity = weight) becomes
+     *        a forward arc at u and a zero-capacity reverse arc at v.
+     */
+    struct ResidualGraph {
+        int n;
+        long long* offsets;
+        int* heads;
+        int* partner;
+        long long* cap;
+
+        ResidualGraph(Graph& g) {
+            n = g.getNumVertices();
+            Node** adjList = g.getAdjList();
+            offsets = new long long[n + 1];
+            for (int v = 0; v <= n; v++) offsets[v] = 0;
+            for (int u = 0; u < n; u++) {
+                for (Node* a = adjList[u]; a != nullptr; a = a->next) {
+                    if (a->weight < 0) {
+                        delete[] offsets;
+                        throw std::invalid_argument("Capacities must not be negative.");
+                    }
+                    offsets[u + 1]++;
+                    offsets[a->vertex + 1]++;
+                }
+            }
+            for (int v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+            heads = new int[offsets[n] > 0 ? offsets[n] : 1];
+            partner = new int[offsets[n] > 0 ? offsets[n] : 1];
+            cap = new long long[offsets[n] > 0 ? offsets[n] : 1];
+            long long* fill = new long long[n > 0 ? n : 1];
+            for (int v = 0; v < n; v++) fill[v] = offsets[v];
+            for (int u = 0; u < n; u++) {
+                for (Node* a = adjList[u]; a != nullptr; a = a->next) {
+                    int v = a->vertex;
+                    long long forward = fill[u]++;
+                    long long backward = fill[v]++;
+                    heads[forward] = v;
+                    cap[forward] = a->weight;
+                    partner[forward] = (int)backward;
+                    heads[backward] = u;
+                    cap[backward] = 0;
+                    partner[backward] = (int)forward;
+                }
+            }
+            delete[] fill;
+        }
+
+        ~ResidualGraph() {
+            delete[] offsets;
+            delete[] heads;
+            delete[] partner;
+            delete[] cap;
+        }
+
+        /**
+         * @brief BFS over reverse residual arcs: dist[v] is the number of residual arcs from v to target,
+         *        or unreachable if v cannot reach it.
+         */
+        void distancesTo(int target, int* dist, int unreachable) {
+            for (int v = 0; v < n; v++) dist[v] = unreachable;
+            Queue queue;
+            dist[target] = 0;
+            queue.enqueue(target);
+            while (!queue.isEmpty()) {
+                int v = queue.dequeue();
+                for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                    int u = heads[e];
+                    if (dist[u] == unreachable && cap[partner[e]] > 0) {
+                        dist[u] = dist[v] + 1;
+                        queue.enqueue(u);
+                    }
+                }
+                STAT_ADD(edgesScanned, offsets[v + 1] - offsets[v]);
+            }
+        }
+    };
+
+    /**
+     * @brief Dinic: BFS levels from the source, then blocking flow by repeated iterative DFS along
+     *        level-increasing arcs with a per-vertex current-arc pointer; dead ends are pruned.
+     */
+    long long dinic(ResidualGraph& r, int source, int sink) {
+        int n = r.n;
+        int* level = new int[n];
+        long long* current = new long long[n];
+        long long* pathArcs = new long long[n];
+        int* pathTails = new int[n];
+        long long flow = 0;
+        while (true) {
+            for (int v = 0; v < n; v++) level[v] = -1;
+            Queue queue;
+            level[source] = 0;
+            queue.enqueue(source);
+            while (!queue.isEmpty()) {
+                int v = queue.dequeue();
+                for (long long e = r.offsets[v]; e < r.offsets[v + 1]; e++) {
+                    if (r.cap[e] > 0 && level[r.heads[e]] == -1) {
+                        level[r.heads[e]] = level[v] + 1;
+                        queue.enqueue(r.heads[e]);
+                    }
+                }
+                STAT_ADD(edgesScanned, r.offsets[v + 1] - r.offsets[v]);
+            }
+            if (level[sink] == -1) break;
+            for (int v = 0; v < n; v++) current[v] = r.offsets[v];
+
+            int depth = 0;
+            int v = source;
+            while (true) {
+                if (v == sink) {
+                    long long bottleneck = r.cap[pathArcs[0]];
+                    for (int i = 1; i < depth; i++) {
+                        if (r.cap[pathArcs[i]] < bottleneck) bottleneck = r.cap[pathArcs[i]];
+                    }
+                    for (int i = 0; i < depth; i++) {
+                        r.cap[pathArcs[i]] -= bottleneck;
+                        r.cap[r.partner[pathArcs[i]]] += bottleneck;
+                    }
+                    flow += bottleneck;
+                    STAT_ADD(relaxSuccesses, 1);
+                    depth = 0;
+                    v = source;
+                    continue;
+                }
+                long long end = r.offsets[v + 1];
+                while (current[v] < end) {
+                    long long e = current[v];
+                    if (r.cap[e] > 0 && level[r.heads[e]] == level[v] + 1) break;
+                    current[v]++;
+                }
+                if (current[v] < end) {
+                    pathArcs[depth] = current[v];
+                    pathTails[depth] = v;
+                    depth++;
+                    v = r.heads[current[v]];
+                }
+                else {
+                    if (v == source) break;
+                    level[v] = -1; // dead end: nothing reaches the sink through v in this phase
+                    depth--;
+                    v = pathTails[depth];
+                    current[v]++;
+                }
+            }
+            STAT_ADD(verticesSettled, 1); // one phase
+        }
+        delete[] level;
+        delete[] current;
+        delete[] pathArcs;
+        delete[] pathTails;
+        return flow;
+    }
+
+    /**
+     * @brief Highest-label push-relabel (first phase: computes a maximum preflow, whose sink excess is
+     *        the max-flow value). Active vertices wait in per-height buckets and the highest one is
+     *        discharged first. Heights start as exact residual distances to the sink and are recomputed
+     *        by a global relabel (reverse BFS) after every V + E units of relabel work; vertices that
+     *        can no longer reach the sink get height n and are dropped.
+     */
+    long long pushRelabel(ResidualGraph& r, int source, int sink) {
+        int n = r.n;
+        long long arcs = r.offsets[n];
+        int* height = new int[n];
+        long long* excess = new long long[n];
+        long long* current = new long long[n];
+        int* bucket = new int[n + 1];   // first active vertex of each height, -1 if none
+        int* nextActive = new int[n];   // singly linked bucket lists
+        for (int v = 0; v < n; v++) excess[v] = 0;
+
+        int highest = -1;
+        auto activate = [&](int v) {
+            nextActive[v] = bucket[height[v]];
+            bucket[height[v]] = v;
+            if (height[v] > highest) highest = height[v];
+        };
+        auto globalRelabel = [&]() {
+            r.distancesTo(sink, height, n);
+            height[source] = n;
+            for (int h = 0; h <= n; h++) bucket[h] = -1;
+            highest = -1;
+            for (int v = 0; v < n; v++) {
+                current[v] = r.offsets[v];
+                if (v != source && v != sink && excess[v] > 0 && height[v] < n) activate(v);
+            }
+            STAT_ADD(verticesSettled, 1);
+        };
+
+        for (long long e = r.offsets[source]; e < r.offsets[source + 1]; e++) {
+            long long f = r.cap[e];
+            if (f == 0) continue;
+            r.cap[e] = 0;
+            r.cap[r.partner[e]] += f;
+            excess[r.heads[e]] += f;
+            excess[source] -= f;
+        }
+        globalRelabel();
+
+        long long work = 0;
+        while (highest >= 0) {
+            int v = bucket[highest];
+            if (v == -1) {
+                highest--;
+                continue;
+            }
+            bucket[highest] = nextActive[v];
+
+            // discharge v
+            while (excess[v] > 0) {
+                long long end = r.offsets[v + 1];
+                if (current[v] == end) {
+                    int lowest = 2 * n;
+                    for (long long e = r.offsets[v]; e < end; e++) {
+                        if (r.cap[e] > 0 && height[r.heads[e]] < lowest) lowest = height[r.heads[e]];
+                    }
+                    work += end - r.offsets[v] + 12;
+                    STAT_ADD(edgesScanned, end - r.offsets[v]);
+                    height[v] = lowest + 1 < n ? lowest + 1 : n;
+                    current[v] = r.offsets[v];
+                    if (height[v] >= n) break; // cannot reach the sink any more
+                    continue;
+                }
+                long long e = current[v];
+                int w = r.heads[e];
+                if (r.cap[e] > 0 && height[v] == height[w] + 1) {
+                    long long f = excess[v] < r.cap[e] ? excess[v] : r.cap[e];
+                    r.cap[e] -= f;
+                    r.cap[r.partner[e]] += f;
+                    excess[v] -= f;
+                    if (excess[w] == 0 && w != sink && w != source) activate(w);
+                    excess[w] += f;
+                    STAT_ADD(relaxSuccesses, 1);
+                }
+                else {
+                    current[v]++;
+                }
+            }
+            if (work > n + arcs) {
+                globalRelabel();
+                work = 0;
+            }
+        }
+        long long flow = excess[sink];
+        delete[] height;
+        delete[] excess;
+        delete[] current;
+        delete[] bucket;
+        delete[] nextActive;
+        return flow;
+    }
+
+}
+
+    /**
+     * @brief Computes a maximum flow from source to sink, where every arc's weight is its capacity
+     *        (an undirected edge allows its capacity in both directions). Both algorithms run on a
+     *        residual network with paired reverse-arc indices rather than the adjacency lists.
+     * 
+     * @param g The graph (non-negative weights).
+     * @param source The source vertex.
+     * @param sink The sink vertex.
+     * @param algorithm MAXFLOW_DINIC or MAXFLOW_PUSH_RELABEL.
+     * @param sourceSide Optional output array of size V: true for the vertices on the source side of a
+     *        minimum cut (those that cannot reach the sink in the final residual network).
+     * @return long long The maximum flow value (= minimum cut capacity).
+     * 
+     * @throws std::out_of_range If source or sink is not within the valid range.
+     * @throws std::invalid_argument If source == sink or a capacity is negative.
+     */
+    long long Algorithms::maxFlow(Graph& g, int source, int sink, MaxFlowAlgorithm algorithm, bool* sourceSide) {
+        int V = g.getNumVertices();
+        if (source < 0 || source >= V || sink < 0 || sink >= V) {
+            throw std::out_of_range("Vertex index out of range.");
+        }
+        if (source == sink) {
+            throw std::invalid_argument("Source and sink must differ.");
+        }
+        STAT_RESET();
+        ResidualGraph r(g);
+        long long flow = algorithm == MAXFLOW_PUSH_RELABEL ? pushRelabel(r, source, sink) : dinic(r, source, sink);
+        if (sourceSide != nullptr) {
+            int* dist = new int[V];
+            r.distancesTo(sink, dist, -1);
+            for (int v = 0; v < V; v++) sourceSide[v] = dist[v] == -1;
+            delete[] dist;
+        }
+        return flow;
+    }
+
+
+// ============================
+//        MATCHING SECTION
+// ============================
+    /**
+     * @brief Checks whether an undirected graph is bipartite by BFS 2-coloring every component.
+     * 
+     * @param g The graph.
+     * @param side Optional output array of size V with a valid side (0 or 1) per vertex;
+     *        the smallest vertex of every component gets side 0. Undefined if the graph is not bipartite.
+     * @return true If no edge joins two vertices of the same side (a self loop never does).
+     */
+    bool Algorithms::isBipartite(Graph& g, int* side) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        Node** adjList = g.getAdjList();
+        int* color = side != nullptr ? side : new int[V];
+        for (int v = 0; v < V; v++) {
+            color[v] = -1;
+        }
+        bool bipartite = true;
+        Queue queue;
+        for (int start = 0; start < V && bipartite; start++) {
+            if (color[start] != -1) continue;
+            color[start] = 0;
+            queue.enqueue(start);
+            while (!queue.isEmpty()) {
+                int v = queue.dequeue();
+                STAT_ADD(verticesSettled, 1);
+                for (Node* n = adjList[v]; n != nullptr; n = n->next) {
+                    STAT_ADD(edgesScanned, 1);
+                    if (color[n->vertex] == -1) {
+                        color[n->vertex] = 1 - color[v];
+                        queue.enqueue(n->vertex);
+                    }
+                    else if (color[n->vertex] == color[v]) {
+                        bipartite = false;
+                    }
+                }
+            }
+        }
+        if (side == nullptr) delete[] color;
+        return bipartite;
+    }
+
+    /**
+     * @brief Computes a maximum matching of an undirected bipartite graph with Hopcroft-Karp, O(E sqrt(V)).
+     *        Each phase runs a BFS (Queue) from all free left vertices that layers the left side by
+     *        alternating-path length, then an iterative DFS with current-arc pointers finds a maximal
+     *        set of vertex-disjoint shortest augmenting paths. The sides come from isBipartite.
+     * 
+     * @param g The graph (built with addEdge).
+     * @param mate Output array of size V: the matched partner of each vertex, or -1.
+     * @return int The number of matched pairs.
+     * 
+     * @throws std::invalid_argument If the graph is not bipartite.
+     */
+    int Algorithms::maxBipartiteMatching(Graph& g, int* mate) {
+        int V = g.getNumVertices();
+        int* side = new int[V];
+        if (!isBipartite(g, side)) {
+            delete[] side;
+            throw std::invalid_argument("Graph is not bipartite.");
+        }
+        STAT_RESET();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int leftCount = 0;
+        for (int v = 0; v < V; v++) {
+            mate[v] = -1;
+            if (side[v] == 0) leftCount++;
+        }
+        int* left = new int[leftCount > 0 ? leftCount : 1];
+        for (int v = 0, i = 0; v < V; v++) {
+            if (side[v] == 0) left[i++] = v;
+        }
+
+        const int unreached = 2147483647;
+        int* dist = new int[V];          // BFS layer of each left vertex
+        long long* current = new long long[V];
+        int* path = new int[V];          // left vertices of the DFS path
+        int matched = 0;
+        Queue queue;
+
+        while (true) {
+            // BFS: layer the left side from the free left vertices
+            int freeLayer = unreached; // length of the shortest augmenting paths
+            for (int i = 0; i < leftCount; i++) {
+                int u = left[i];
+                if (mate[u] == -1) {
+                    dist[u] = 0;
+                    queue.enqueue(u);
+                }
+                else {
+                    dist[u] = unreached;
+                }
+            }
+            while (!queue.isEmpty()) {
+                int u = queue.dequeue();
+                if (dist[u] >= freeLayer) continue;
+                STAT_ADD(edgesScanned, offsets[u + 1] - offsets[u]);
+                for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                    int m = mate[targets[e]];
+                    if (m == -1) {
+                        if (freeLayer == unreached) freeLayer = dist[u] + 1;
+                    }
+                    else if (dist[m] == unreached) {
+                        dist[m] = dist[u] + 1;
+                        queue.enqueue(m);
+                    }
+                }
+            }
+            if (freeLayer == unreached) break;
+            STAT_ADD(verticesSettled, 1); // one phase
+
+            // DFS: vertex-disjoint shortest augmenting paths along the layers
+            for (int i = 0; i < leftCount; i++) current[left[i]] = offsets[left[i]];
+            for (int i = 0; i < leftCount; i++) {
+                if (mate[left[i]] != -1) continue;
+                int top = 0;
+                path[0] = left[i];
+                while (top >= 0) {
+                    int u = path[top];
+                    if (current[u] == offsets[u + 1]) {
+                        dist[u] = unreached; // dead end for the rest of the phase
+                        top--;
+                        if (top >= 0) current[path[top]]++;
+                        continue;
+                    }
+                    int w = targets[current[u]];
+                    int m = mate[w];
+                    if (m == -1 && dist[u] + 1 == freeLayer) {
+                        // flip the path: every left vertex takes the right vertex its current arc points to
+                        for (int k = top; k >= 0; k--) {
+                            int x = path[k];
+                            int y = targets[current[x]];
+                            mate[x] = y;
+                            mate[y] = x;
+                            dist[x] = unreached; // used, keep the paths disjoint
+                        }
+                        matched++;
+                        STAT_ADD(relaxSuccesses, 1);
+                        break;
+                    }
+                    if (m != -1 && dist[m] == dist[u] + 1) {
+                        path[++top] = m;
+                    }
+                    else {
+                        current[u]++;
+                    }
+                }
+            }
+        }
+
+        delete[] side;
+        delete[] left;
+        delete[] dist;
+        delete[] current;
+        delete[] path;
+        return matched;
+    }
+
+
+// ============================
+//          DAG SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Kahn's algorithm over CSR rows: a Queue holds the vertices whose remaining in-degree is 0.
+     * 
+     * @return int The number of vertices ordered (V exactly when the graph is acyclic).
+     */
+    int kahnOrder(int V, long long* offsets, int* targets, int* order) {
+        int* inDegree = new int[V];
+        for (int v = 0; v < V; v++) inDegree[v] = 0;
+        for (long long e = 0; e < offsets[V]; e++) inDegree[targets[e]]++;
+        Queue queue;
+        for (int v = 0; v < V; v++) {
+            if (inDegree[v] == 0) queue.enqueue(v);
+        }
+        int count = 0;
+        while (!queue.isEmpty()) {
+            int v = queue.dequeue();
+            order[count++] = v;
+            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                if (--inDegree[targets[e]] == 0) queue.enqueue(targets[e]);
+            }
+            STAT_PEAK(queuePeak, queue.getSize());
+        }
+        delete[] inDegree;
+        return count;
+    }
+
+}
+    /**
+     * @brief Orders the vertices of a directed graph so that every arc goes forward (Kahn's algorithm).
+     *        One thread: a Queue of vertices whose remaining in-degree is 0, O(V + E).
+     *        More threads: level by level. The whole zero in-degree frontier is processed in parallel,
+     *        in-degrees drop with atomic decrements, and the vertex whose counter reaches 0 joins the
+     *        next level. Each level is sorted by vertex id, so the result does not depend on timing.
+     * 
+     * @param g The graph (built with addDirectedEdge; an undirected edge is a 2-cycle).
+     * @param order Output array of size V with the topological order.
+     * @param numThreads Number of threads.
+     * @return true If the graph is acyclic; false if it has a cycle (order then holds only the
+     *         vertices that precede every cycle).
+     */
+    bool Algorithms::topologicalSort(Graph& g, int* order, int numThreads) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int count = 0;
+
+        if (numThreads <= 1) {
+            count = kahnOrder(V, offsets, targets, order);
+        }
+        else {
+            std::atomic<int>* inDegree = new std::atomic<int>[V];
+            for (int v = 0; v < V; v++) inDegree[v].store(0, std::memory_order_relaxed);
+            for (long long e = 0; e < offsets[V]; e++) inDegree[targets[e]].fetch_add(1, std::memory_order_relaxed);
+            for (int v = 0; v < V; v++) {
+                if (inDegree[v].load(std::memory_order_relaxed) == 0) order[count++] = v;
+            }
+            // order[levelStart, count) is the current level; the next one is appended right after it
+            int levelStart = 0;
+            while (levelStart < count) {
+                int levelEnd = count;
+                std::atomic<int> next(levelEnd);
+                parallelFor(levelEnd - levelStart, levelEnd - levelStart < 1024 ? 1 : numThreads, [&](int begin, int end, int) {
+                    for (int i = levelStart + begin; i < levelStart + end; i++) {
+                        int v = order[i];
+                        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                            int w = targets[e];
+                            if (inDegree[w].fetch_sub(1, std::memory_order_acq_rel) == 1) order[next.fetch_add(1)] = w;
+                        }
+                    }
+                });
+                count = next.load();
+                sortByKey(order + levelEnd, count - levelEnd, [](int v) { return (long long)v; });
+                STAT_PEAK(queuePeak, count - levelEnd);
+                levelStart = levelEnd;
+            }
+            delete[] inDegree;
+        }
+        STAT_ADD(verticesSettled, count);
+        STAT_ADD(edgesScanned, offsets[V]);
+        return count == V;
+    }
+
+    /**
+     * @brief Computes shortest or longest path distances from a source in a DAG in O(V + E):
+     *        arcs are relaxed in topological order, so every vertex is final when it is reached.
+     *        Negative weights are fine (there are no cycles).
+     * 
+     * @param g The graph (must be acyclic).
+     * @param start The source vertex.
+     * @param distances Output array of size V. Unreachable vertices get 2147483647 for shortest paths
+     *        and -2147483648 for longest paths.
+     * @param longest Compute longest (critical) paths instead of shortest ones.
+     * @param parent Optional output array of size V with each vertex's predecessor (-1 for none).
+     * 
+     * @throws std::out_of_range If the start vertex is not within the valid range.
+     * @throws std::invalid_argument If the graph has a cycle.
+     */
+    void Algorithms::dagShortestPaths(Graph& g, int start, int* distances, bool longest, int* parent) {
+        int V = g.getNumVertices();
+        if (start < 0 || start >= V) {
+            throw std::out_of_range("Invalid start vertex in DAG SHORTEST PATHS");
+        }
+        STAT_RESET();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        int* order = new int[V];
+        if (kahnOrder(V, offsets, targets, order) < V) {
+            delete[] order;
+            throw std::invalid_argument("Graph contains a cycle.");
+        }
+        const int unreached = longest ? -2147483647 - 1 : 2147483647;
+        for (int v = 0; v < V; v++) {
+            distances[v] = unreached;
+            if (parent != nullptr) parent[v] = -1;
+        }
+        distances[start] = 0;
+
+        int first = 0;
+        while (order[first] != start) first++; // nothing before start is reachable from it
+        for (int i = first; i < V; i++) {
+            int u = order[i];
+            if (distances[u] == unreached) continue;
+            STAT_ADD(verticesSettled, 1);
+            STAT_ADD(edgesScanned, offsets[u + 1] - offsets[u]);
+            for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                int v = targets[e];
+                int through = distances[u] + weights[e];
+                if (distances[v] == unreached || (longest ? through > distances[v] : through < distances[v])) {
+                    distances[v] = through;
+                    if (parent != nullptr) parent[v] = u;
+                    STAT_ADD(relaxSuccesses, 1);
+                }
+            }
+        }
+        delete[] order;
+    }
+
+
+// ============================
+//        COLORING SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Gives v the smallest color not used by an already colored neighbor.
+     * 
+     * @param mark Scratch array of size maxDegree + 1; mark[c] == v means color c is taken.
+     * @return int The chosen color.
+     */
+    int firstFreeColor(int v, long long* offsets, int* targets, int* colors, int* mark) {
+        int degree = (int)(offsets[v + 1] - offsets[v]);
+        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+            int c = colors[targets[e]];
+            if (c >= 0 && c <= degree) mark[c] = v; // a color above the degree can never be the smallest free one
+        }
+        int color = 0;
+        while (color <= degree && mark[color] == v) color++;
+        return color;
+    }
+
+}
+    /**
+     * @brief Colors the vertices so that no two adjacent vertices share a color (self loops are ignored).
+     *        Every strategy is greedy: each vertex takes the smallest color not used by a neighbor colored
+     *        before it, so at most maxDegree + 1 colors are used.
+     *        COLORING_LARGEST_FIRST: vertices by descending degree (bucket sorted), O(V + E).
+     *        COLORING_SMALLEST_LAST: reverse of the minimum-degree peeling order, O(V + E); uses at most
+     *        degeneracy + 1 colors.
+     *        COLORING_JONES_PLASSMANN: every vertex gets a priority (larger log2 degree first, a seeded hash
+     *        breaking ties), and a vertex is colored once all its higher-priority neighbors are. Each round
+     *        colors an independent set in parallel and counts down the predecessors of its neighbors
+     *        atomically, so there are no conflicts to repair and the result does not depend on numThreads.
+     * 
+     * @param g The graph (undirected).
+     * @param colors Output array of size V with colors 0, 1, ...
+     * @param strategy Vertex ordering.
+     * @param numThreads Number of threads (COLORING_JONES_PLASSMANN only).
+     * @param seed Seed of the Jones-Plassmann priorities.
+     * @return int The number of colors used.
+     */
+    int Algorithms::greedyColoring(Graph& g, int* colors, ColoringStrategy strategy, int numThreads,
+                                   unsigned long long seed) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        if (V == 0) return 0;
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int maxDegree = 0;
+        for (int v = 0; v < V; v++) {
+            colors[v] = -1;
+            int degree = (int)(offsets[v + 1] - offsets[v]);
+            if (degree > maxDegree) maxDegree = degree;
+        }
+
+        if (strategy == COLORING_LARGEST_FIRST || strategy == COLORING_SMALLEST_LAST) {
+            int* order = new int[V];
+            if (strategy == COLORING_LARGEST_FIRST) {
+                int* binStart = new int[maxDegree + 2];
+                for (int d = 0; d <= maxDegree + 1; d++) binStart[d] = 0;
+                for (int v = 0; v < V; v++) binStart[maxDegree - (int)(offsets[v + 1] - offsets[v]) + 1]++;
+                for (int d = 0; d <= maxDegree; d++) binStart[d + 1] += binStart[d];
+                for (int v = 0; v < V; v++) order[binStart[maxDegree - (int)(offsets[v + 1] - offsets[v])]++] = v;
+                delete[] binStart;
+            }
+            else {
+                int* cores = new int[V];
+                peelByDegree(V, offsets, targets, cores, order);
+                delete[] cores;
+                for (int i = 0, j = V - 1; i < j; i++, j--) {
+                    int temp = order[i];
+                    order[i] = order[j];
+                    order[j] = temp;
+                }
+            }
+            int* mark = new int[maxDegree + 1];
+            for (int c = 0; c <= maxDegree; c++) mark[c] = -1;
+            for (int i = 0; i < V; i++) {
+                colors[order[i]] = firstFreeColor(order[i], offsets, targets, colors, mark);
+            }
+            delete[] mark;
+            delete[] order;
+        }
+        else {
+            if (numThreads < 1) numThreads = 1;
+            // priority: log2 degree in the high word, a hash of the id in the low word, the id itself last
+            unsigned long long* priority = new unsigned long long[V];
+            for (int v = 0; v < V; v++) {
+                unsigned long long z = ((unsigned long long)v + 1) * 0x9E3779B97F4A7C15ULL ^ seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                z ^= z >> 31;
+                int degree = (int)(offsets[v + 1] - offsets[v]);
+                unsigned long long logDegree = degree > 0 ? 32 - __builtin_clz((unsigned)degree) : 0;
+                priority[v] = (logDegree << 32) | (z >> 32);
+            }
+            auto before = [&](int u, int v) {
+                return priority[u] > priority[v] || (priority[u] == priority[v] && u < v);
+            };
+
+            std::atomic<int>* waiting = new std::atomic<int>[V]; // uncolored higher-priority neighbors
+            int* frontier = new int[V];
+            int* nextFrontier = new int[V];
+            int frontierSize = 0;
+            for (int v = 0; v < V; v++) {
+                int count = 0;
+                for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                    int u = targets[e];
+                    if (u != v && before(u, v)) count++;
+                }
+                waiting[v].store(count, std::memory_order_relaxed);
+                if (count == 0) frontier[frontierSize++] = v;
+            }
+
+            int* marks = new int[(long long)numThreads * (maxDegree + 1)];
+            for (long long i = 0; i < (long long)numThreads * (maxDegree + 1); i++) marks[i] = -1;
+            while (frontierSize > 0) {
+                // the frontier is independent: its vertices only read colors fixed in earlier rounds
+                std::atomic<int> nextSize(0);
+                parallelFor(frontierSize, frontierSize < 1024 ? 1 : numThreads, [&](int begin, int end, int tid) {
+                    int* mark = marks + (long long)tid * (maxDegree + 1);
+                    for (int i = begin; i < end; i++) {
+                        int v = frontier[i];
+                        colors[v] = firstFreeColor(v, offsets, targets, colors, mark);
+                        for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                            int u = targets[e];
+                            if (u == v || !before(v, u)) continue;
+                            if (waiting[u].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                                nextFrontier[nextSize.fetch_add(1)] = u;
+                            }
+                        }
+                    }
+                });
+                STAT_PEAK(queuePeak, frontierSize);
+                int* temp = frontier;
+                frontier = nextFrontier;
+                nextFrontier = temp;
+                frontierSize = nextSize.load();
+            }
+            delete[] priority;
+            delete[] waiting;
+            delete[] frontier;
+            delete[] nextFrontier;
+            delete[] marks;
+            STAT_ADD(edgesScanned, offsets[V]);
+        }
+
+        int numColors = 0;
+        for (int v = 0; v < V; v++) {
+            if (colors[v] + 1 > numColors) numColors = colors[v] + 1;
+        }
+        STAT_ADD(verticesSettled, V);
+        STAT_ADD(edgesScanned, offsets[V]);
+        return numColors;
+    }
+
+
+// ============================
+//        LOUVAIN SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Open-addressing table from label (or community) to summed edge weight, sized for the largest
+     *        row, so a hub costs O(degree) memory per thread instead of O(V). Cleared slot by slot after
+     *        each row. Shared by Louvain and label propagation.
+     */
+    struct LabelCounter {
+        int shift;          // Fibonacci hashing keeps the top bits of label * 2^32 / phi
+        int mask;
+        int* keys;          // -1 marks an empty slot
+        long long* counts;
+        int* used;          // occupied slots, in insertion order
+        int numUsed;
+
+        LabelCounter(int maxDegree) : numUsed(0) {
+            int bits = 1;
+            while ((1LL << bits) < 2LL * maxDegree) bits++;
+            shift = 32 - bits;
+            mask = (1 << bits) - 1;
+            keys = new int[mask + 1];
+            counts = new long long[mask + 1];
+            used = new int[mask + 1];
+            for (int i = 0; i <= mask; i++) keys[i] = -1;
+        }
+
+        ~LabelCounter() {
+            delete[] keys;
+            delete[] counts;
+            delete[] used;
+        }
+
+        void add(int label, long long weight) {
+            int slot = (int)(((unsigned)label * 0x9E3779B1u) >> shift);
+            while (keys[slot] != label) {
+                if (keys[slot] < 0) {
+                    keys[slot] = label;
+                    counts[slot] = 0;
+                    used[numUsed++] = slot;
+                    break;
+                }
+                slot = (slot + 1) & mask;
+            }
+            counts[slot] += weight;
+        }
+
+        int size() { return numUsed; }
+
+        // k-th distinct label added since the last clear, in insertion order
+        int labelAt(int k) { return keys[used[k]]; }
+
+        long long countAt(int k) { return counts[used[k]]; }
+
+        void clear() {
+            for (int i = 0; i < numUsed; i++) keys[used[i]] = -1;
+            numUsed = 0;
+        }
+
+        /**
+         * @brief Returns the heaviest label (keeping current on a tie, else the smallest one) and empties the table.
+         */
+        int takeBest(int current) {
+            int best = current;
+            long long bestCount = -1;
+            for (int i = 0; i < numUsed; i++) {
+                int slot = used[i];
+                int label = keys[slot];
+                long long count = counts[slot];
+                if (count > bestCount || (count == bestCount && best != current && (label == current || label < best))) {
+                    best = label;
+                    bestCount = count;
+                }
+                keys[slot] = -1;
+            }
+            numUsed = 0;
+            return best;
+        }
+    };
+
+    /**
+     * @brief Weighted CSR graph of one Louvain level. Row i holds the communities of the previous level
+     *        adjacent to community i; a community's internal weight is a single self arc.
+     */
+    struct LevelGraph {
+        int n;
+        long long* offsets;
+        int* targets;
+        long long* weights;
+
+        LevelGraph() : n(0), offsets(nullptr), targets(nullptr), weights(nullptr) {}
+
+        ~LevelGraph() {
+            delete[] offsets;
+            delete[] targets;
+            delete[] weights;
+        }
+
+        void swap(LevelGraph& other) {
+            int tempN = n;
+            long long* tempOffsets = offsets;
+            int* tempTargets = targets;
+            long long* tempWeights = weights;
+            n = other.n;
+            offsets = other.offsets;
+            targets = other.targets;
+            weights = other.weights;
+            other.n = tempN;
+            other.offsets = tempOffsets;
+            other.targets = tempTargets;
+            other.weights = tempWeights;
+        }
+    };
+
+    /**
+     * @brief Modularity of a partition of a level graph: in / 2m - sum of (tot / 2m)^2, where in is the
+     *        weight of the arcs inside communities and tot the summed strength of each community.
+     */
+    double levelModularity(LevelGraph& level, const int* comm, const long long* tot, double totalWeight,
+                           int numThreads) {
+        long long* inside = new long long[numThreads];
+        double* squares = new double[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            inside[t] = 0;
+            squares[t] = 0.0;
+        }
+        parallelFor(level.n, numThreads, [&](int begin, int end, int tid) {
+            for (int i = begin; i < end; i++) {
+                for (long long e = level.offsets[i]; e < level.offsets[i + 1]; e++) {
+                    if (comm[level.targets[e]] == comm[i]) inside[tid] += level.weights[e];
+                }
+                squares[tid] += (double)tot[i] * (double)tot[i];
+            }
+        }, 1024);
+        long long in = 0;
+        double sum = 0.0;
+        for (int t = 0; t < numThreads; t++) {
+            in += inside[t];
+            sum += squares[t];
+        }
+        delete[] inside;
+        delete[] squares;
+        return (double)in / totalWeight - sum / (totalWeight * totalWeight);
+    }
+
+    /**
+     * @brief Collapses every community of a level into one vertex of the next level, summing parallel arcs.
+     * 
+     * @param comm Community of each vertex, renumbered to 0 .. numCommunities - 1.
+     */
+    void coarsen(LevelGraph& level, const int* comm, int numCommunities, LevelGraph& next, int numThreads) {
+        int n = level.n;
+        int* memberStart = new int[numCommunities + 1];
+        int* members = new int[n];
+        for (int c = 0; c <= numCommunities; c++) memberStart[c] = 0;
+        for (int i = 0; i < n; i++) memberStart[comm[i] + 1]++;
+        for (int c = 0; c < numCommunities; c++) memberStart[c + 1] += memberStart[c];
+        for (int i = 0; i < n; i++) members[memberStart[comm[i]]++] = i;
+        for (int c = numCommunities; c > 0; c--) memberStart[c] = memberStart[c - 1];
+        memberStart[0] = 0;
+
+        // a row has at most as many distinct neighbors as its members have arcs (and communities exist)
+        int maxRow = 0;
+        for (int c = 0; c < numCommunities; c++) {
+            long long arcs = 0;
+            for (int m = memberStart[c]; m < memberStart[c + 1]; m++) {
+                arcs += level.offsets[members[m] + 1] - level.offsets[members[m]];
+            }
+            if (arcs > numCommunities) arcs = numCommunities;
+            if (arcs > maxRow) maxRow = (int)arcs;
+        }
+        LabelCounter** counters = new LabelCounter*[numThreads];
+        for (int t = 0; t < numThreads; t++) counters[t] = new LabelCounter(maxRow);
+
+        next.n = numCommunities;
+        next.offsets = new long long[numCommunities + 1];
+        // first pass counts the distinct neighbor communities of each row, the second one fills the rows
+        for (int fill = 0; fill < 2; fill++) {
+            parallelFor(numCommunities, numThreads, [&](int begin, int end, int tid) {
+                LabelCounter& counter = *counters[tid];
+                for (int c = begin; c < end; c++) {
+                    for (int m = memberStart[c]; m < memberStart[c + 1]; m++) {
+                        int i = members[m];
+                        for (long long e = level.offsets[i]; e < level.offsets[i + 1]; e++) {
+                            counter.add(comm[level.targets[e]], level.weights[e]);
+                        }
+                    }
+                    int count = counter.size();
+                    if (fill == 1) {
+                        for (int j = 0; j < count; j++) {
+                            next.targets[next.offsets[c] + j] = counter.labelAt(j);
+                            next.weights[next.offsets[c] + j] = counter.countAt(j);
+                        }
+                    }
+                    counter.clear();
+                    if (fill == 0) next.offsets[c + 1] = count;
+                }
+            }, 256);
+            if (fill == 0) {
+                next.offsets[0] = 0;
+                for (int c = 0; c < numCommunities; c++) next.offsets[c + 1] += next.offsets[c];
+                next.targets = new int[next.offsets[numCommunities]];
+                next.weights = new long long[next.offsets[numCommunities]];
+            }
+        }
+        for (int t = 0; t < numThreads; t++) delete counters[t];
+        delete[] counters;
+        delete[] memberStart;
+        delete[] members;
+    }
+
+}
+    /**
+     * @brief Computes the modularity of a partition: the fraction of edge weight inside communities minus
+     *        the fraction expected if edges were rewired at random with the same vertex strengths.
+     * 
+     * @param g The graph (undirected, non-negative weights).
+     * @param communities Community label of every vertex, in [0, V).
+     * @return double The modularity, in [-0.5, 1); 0 for a graph without edge weight.
+     * 
+     * @throws std::invalid_argument If a label is out of range or a weight is negative.
+     */
+    double Algorithms::modularity(Graph& g, const int* communities) {
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        long long* tot = new long long[V];
+        for (int c = 0; c < V; c++) tot[c] = 0;
+        for (int v = 0; v < V; v++) {
+            if (communities[v] < 0 || communities[v] >= V) {
+                delete[] tot;
+                throw std::invalid_argument("Community labels must be in [0, V).");
+            }
+        }
+        long long in = 0, total = 0;
+        for (int v = 0; v < V; v++) {
+            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                if (weights[e] < 0) {
+                    delete[] tot;
+                    throw std::invalid_argument("Modularity requires non-negative weights.");
+                }
+                tot[communities[v]] += weights[e];
+                total += weights[e];
+                if (communities[targets[e]] == communities[v]) in += weights[e];
+            }
+        }
+        double sum = 0.0;
+        for (int c = 0; c < V; c++) sum += (double)tot[c] * (double)tot[c];
+        delete[] tot;
+        if (total == 0) return 0.0;
+        return (double)in / (double)total - sum / ((double)total * (double)total);
+    }
+
+    /**
+     * @brief Louvain community detection. Each pass moves vertices between communities while modularity
+     *        grows (local moving), then collapses every community into one vertex of a new compact weighted
+     *        CSR graph (coarsening); passes repeat on the smaller graph until no vertex moves.
+     *        Local moving is scheduled by a greedy coloring of the level graph: the vertices of one color
+     *        class are never adjacent, so all of them pick their best community in parallel against the same
+     *        community totals, and the moves are applied together once the class is done. The result is
+     *        therefore the same for any number of threads.
+     * 
+     * @param g The graph (undirected, non-negative weights).
+     * @param communities Output array of size V with community labels 0, 1, ...
+     * @param passModularity Optional output array of size maxPasses with the modularity after each pass.
+     * @param maxPasses Largest number of passes.
+     * @param numThreads Number of threads.
+     * @return int The number of passes that moved at least one vertex.
+     * 
+     * @throws std::invalid_argument If a weight is negative.
+     */
+    int Algorithms::louvain(Graph& g, int* communities, double* passModularity, int maxPasses, int numThreads) {
+        STAT_RESET();
+        if (numThreads < 1) numThreads = 1;
+        int V = g.getNumVertices();
+        LevelGraph level;
+        {
+            CSRGraph csr(g);
+            level.n = V;
+            level.offsets = new long long[V + 1];
+            level.targets = new int[csr.getNumArcs()];
+            level.weights = new long long[csr.getNumArcs()];
+            for (int v = 0; v <= V; v++) level.offsets[v] = csr.getOffsets()[v];
+            for (long long e = 0; e < csr.getNumArcs(); e++) {
+                if (csr.getWeights()[e] < 0) throw std::invalid_argument("Louvain requires non-negative weights.");
+                level.targets[e] = csr.getTargets()[e];
+                level.weights[e] = csr.getWeights()[e];
+            }
+        }
+        long long totalArcWeight = 0; // 2m: every undirected edge counts in both directions
+        for (long long e = 0; e < level.offsets[V]; e++) totalArcWeight += level.weights[e];
+        for (int v = 0; v < V; v++) communities[v] = v;
+        if (totalArcWeight == 0) return 0;
+        double m2 = (double)totalArcWeight;
+
+        int passes = 0;
+        while (passes < maxPasses) {
+            int n = level.n;
+            long long* strength = new long long[n];
+            long long* tot = new long long[n];
+            int* comm = new int[n];
+            int* best = new int[n];
+            int maxDegree = 0;
+            for (int i = 0; i < n; i++) {
+                strength[i] = 0;
+                for (long long e = level.offsets[i]; e < level.offsets[i + 1]; e++) strength[i] += level.weights[e];
+                tot[i] = strength[i];
+                comm[i] = i;
+                int degree = (int)(level.offsets[i + 1] - level.offsets[i]);
+                if (degree > maxDegree) maxDegree = degree;
+            }
+
+            // color classes in vertex order, bucketed so each class is a contiguous range of byColor
+            int* color = new int[n];
+            int* mark = new int[maxDegree + 1];
+            int numColors = 0;
+            for (int c = 0; c <= maxDegree; c++) mark[c] = -1;
+            for (int i = 0; i < n; i++) color[i] = -1;
+            for (int i = 0; i < n; i++) {
+                color[i] = firstFreeColor(i, level.offsets, level.targets, color, mark);
+                if (color[i] + 1 > numColors) numColors = color[i] + 1;
+            }
+            int* classStart = new int[numColors + 1];
+            int* byColor = new int[n];
+            for (int c = 0; c <= numColors; c++) classStart[c] = 0;
+            for (int i = 0; i < n; i++) classStart[color[i] + 1]++;
+            for (int c = 0; c < numColors; c++) classStart[c + 1] += classStart[c];
+            for (int i = 0; i < n; i++) byColor[classStart[color[i]]++] = i;
+            for (int c = numColors; c > 0; c--) classStart[c] = classStart[c - 1];
+            classStart[0] = 0;
+            delete[] color;
+            delete[] mark;
+
+            LabelCounter** counters = new LabelCounter*[numThreads];
+            for (int t = 0; t < numThreads; t++) counters[t] = new LabelCounter(maxDegree + 1); // + own community
+            int* savedComm = new int[n];
+            long long* savedTot = new long long[n];
+            double modularity = levelModularity(level, comm, tot, m2, numThreads);
+            bool movedThisPass = false;
+            for (int sweep = 0; sweep < 100; sweep++) {
+                for (int i = 0; i < n; i++) {
+                    savedComm[i] = comm[i];
+                    savedTot[i] = tot[i];
+                }
+                long long moves = 0;
+                for (int c = 0; c < numColors; c++) {
+                    int classSize = classStart[c + 1] - classStart[c];
+                    parallelFor(classSize, classSize < 1024 ? 1 : numThreads, [&](int begin, int end, int tid) {
+                        LabelCounter& counter = *counters[tid];
+                        for (int j = classStart[c] + begin; j < classStart[c] + end; j++) {
+                            int i = byColor[j];
+                            int own = comm[i];
+                            counter.add(own, 0); // slot 0, even without arcs into it
+                            for (long long e = level.offsets[i]; e < level.offsets[i + 1]; e++) {
+                                int u = level.targets[e];
+                                if (u == i) continue; // the self arc moves along with i
+                                counter.add(comm[u], level.weights[e]);
+                            }
+                            // gain of joining d, up to a common factor: w(i, d) - strength(i) * tot(d) / 2m
+                            double ki = (double)strength[i];
+                            double bestGain = (double)counter.countAt(0) - ki * (double)(tot[own] - strength[i]) / m2;
+                            int bestCommunity = own;
+                            for (int k = 1; k < counter.size(); k++) {
+                                int d = counter.labelAt(k);
+                                double gain = (double)counter.countAt(k) - ki * (double)tot[d] / m2;
+                                if (gain > bestGain + 1e-12 || (gain > bestGain - 1e-12 && d < bestCommunity)) {
+                                    bestGain = gain;
+                                    bestCommunity = d;
+                                }
+                            }
+                            counter.clear();
+                            best[i] = bestCommunity;
+                        }
+                    });
+                    for (int j = classStart[c]; j < classStart[c + 1]; j++) {
+                        int i = byColor[j];
+                        if (best[i] == comm[i]) continue;
+                        tot[comm[i]] -= strength[i];
+                        tot[best[i]] += strength[i];
+                        comm[i] = best[i];
+                        moves++;
+                    }
+                }
+                STAT_ADD(edgesScanned, level.offsets[n]);
+                STAT_ADD(relaxSuccesses, moves);
+                if (moves == 0) break;
+                double after = levelModularity(level, comm, tot, m2, numThreads);
+                if (after <= modularity) {
+                    // moves decided against the same totals can cost modularity together; undo the sweep
+                    for (int i = 0; i < n; i++) {
+                        comm[i] = savedComm[i];
+                        tot[i] = savedTot[i];
+                    }
+                    break;
+                }
+                movedThisPass = true;
+                bool converged = after < modularity + 1e-7;
+                modularity = after;
+                if (converged) break;
+            }
+            delete[] savedComm;
+            delete[] savedTot;
+            for (int t = 0; t < numThreads; t++) delete counters[t];
+            delete[] counters;
+            delete[] classStart;
+            delete[] byColor;
+            delete[] strength;
+            delete[] tot;
+            delete[] best;
+            if (!movedThisPass) {
+                delete[] comm;
+                break;
+            }
+
+            // renumber communities by first member, map the original vertices, and collapse the level
+            int* renumber = new int[n];
+            int numCommunities = 0;
+            for (int i = 0; i < n; i++) renumber[i] = -1;
+            for (int i = 0; i < n; i++) {
+                if (renumber[comm[i]] < 0) renumber[comm[i]] = numCommunities++;
+                comm[i] = renumber[comm[i]];
+            }
+            delete[] renumber;
+            for (int v = 0; v < V; v++) communities[v] = comm[communities[v]];
+            if (passModularity != nullptr) passModularity[passes] = modularity;
+            passes++;
+            STAT_ADD(verticesSettled, n);
+
+            LevelGraph next;
+            coarsen(level, comm, numCommunities, next, numThreads);
+            delete[] comm;
+            level.swap(next);
+            if (numCommunities == n) break;
+        }
+        return passes;
+    }
+
+
+// ============================
+//   LABEL PROPAGATION SECTION
+// ============================
+    /**
+     * @brief Label propagation communities (Raghavan, Albert, Kumara). Every vertex starts with its own
+     *        label and repeatedly adopts the label carrying the most edge weight among its neighbors, until
+     *        no label changes. Vertices are visited in a seeded random order, fixed for the whole run.
+     *        Updates are asynchronous: a new label is visible at once to the vertices processed after it,
+     *        which converges in fewer iterations than synchronous rounds and avoids their oscillation on
+     *        bipartite structure. With more threads the order slices are handed out dynamically and
+     *        labels are read and written in place (relaxed atomics), so the result may vary between runs.
+     *        Each iteration is O(E) with per-thread hashed label counters.
+     * 
+     * @param g The graph (undirected, non-negative weights).
+     * @param labels Output array of size V with community labels 0, 1, ...
+     * @param maxIterations Largest number of sweeps over the vertices.
+     * @param numThreads Number of threads.
+     * @param seed Seed of the visiting order.
+     * @return int The number of sweeps performed.
+     * 
+     * @throws std::invalid_argument If a weight is negative.
+     */
+    int Algorithms::labelPropagation(Graph& g, int* labels, int maxIterations, int numThreads, unsigned long long seed) {
+        STAT_RESET();
+        if (numThreads < 1) numThreads = 1;
+        int V = g.getNumVertices();
+        if (V == 0) return 0;
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        int maxDegree = 0;
+        for (int v = 0; v < V; v++) {
+            int degree = (int)(offsets[v + 1] - offsets[v]);
+            if (degree > maxDegree) maxDegree = degree;
+            for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                if (weights[e] < 0) throw std::invalid_argument("Label propagation requires non-negative weights.");
+            }
+        }
+
+        int* order = new int[V];
+        for (int v = 0; v < V; v++) order[v] = v;
+        unsigned long long x = seed * 0x9E3779B97F4A7C15ULL + 1;
+        for (int i = V - 1; i > 0; i--) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            int j = (int)(x % (unsigned long long)(i + 1));
+            int temp = order[i];
+            order[i] = order[j];
+            order[j] = temp;
+        }
+        std::atomic<int>* current = new std::atomic<int>[V];
+        for (int v = 0; v < V; v++) current[v].store(v, std::memory_order_relaxed);
+        LabelCounter** counters = new LabelCounter*[numThreads];
+        for (int t = 0; t < numThreads; t++) counters[t] = new LabelCounter(maxDegree);
+
+        int iterations = 0;
+        while (iterations < maxIterations) {
+            iterations++;
+            std::atomic<long long> changes(0);
+            parallelFor(V, numThreads, [&](int begin, int end, int tid) {
+                LabelCounter& counter = *counters[tid];
+                long long changed = 0;
+                for (int i = begin; i < end; i++) {
+                    int v = order[i];
+                    if (offsets[v] == offsets[v + 1]) continue;
+                    for (long long e = offsets[v]; e < offsets[v + 1]; e++) {
+                        if (targets[e] != v) counter.add(current[targets[e]].load(std::memory_order_relaxed), weights[e]);
+                    }
+                    int own = current[v].load(std::memory_order_relaxed);
+                    int best = counter.takeBest(own);
+                    if (best != own) {
+                        current[v].store(best, std::memory_order_relaxed);
+                        changed++;
+                    }
+                }
+                changes.fetch_add(changed, std::memory_order_relaxed);
+            }, 256);
+            STAT_ADD(edgesScanned, offsets[V]);
+            STAT_ADD(relaxSuccesses, changes.load());
+            if (changes.load() == 0) break;
+        }
+
+        // renumber labels by first vertex
+        int* renumber = new int[V];
+        int numLabels = 0;
+        for (int v = 0; v < V; v++) renumber[v] = -1;
+        for (int v = 0; v < V; v++) {
+            int label = current[v].load(std::memory_order_relaxed);
+            if (renumber[label] < 0) renumber[label] = numLabels++;
+            labels[v] = renumber[label];
+        }
+        STAT_ADD(verticesSettled, (long long)iterations * V);
+        for (int t = 0; t < numThreads; t++) delete counters[t];
+        delete[] counters;
+        delete[] renumber;
+        delete[] current;
+        delete[] order;
+        return iterations;
+    }
+
+
+// ============================
+//     BICONNECTIVITY SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief Iterative Hopcroft-Tarjan over CSR rows. A Stack holds the DFS path, cursor[v] is the next
+     *        arc of v to scan, and a second Stack holds the vertices of the blocks still open. When a child
+     *        u finishes with low[u] >= disc[parent], the vertices above u (u included) close a block.
+     *        Only one arc back to the DFS parent is skipped, so a parallel edge counts as a back edge.
+     * 
+     * @param disc Output array of size V with DFS discovery times.
+     * @param blockOf Output array of size V: the block of the tree edge from each vertex to its DFS parent,
+     *        -1 for DFS roots.
+     * @param articulation Optional output array of size V.
+     * @param bridges Optional output array of size 2 * (V - 1) with (parent, child) pairs.
+     * @param numBridges Set to the number of bridges written.
+     * @return int The number of blocks.
+     */
+    int hopcroftTarjan(int V, long long* offsets, int* targets, int* disc, int* blockOf,
+                       bool* articulation, int* bridges, int& numBridges) {
+        int* low = new int[V];
+        int* parent = new int[V];
+        long long* cursor = new long long[V];
+        bool* skippedParent = new bool[V];
+        for (int v = 0; v < V; v++) {
+            disc[v] = -1;
+            blockOf[v] = -1;
+            cursor[v] = offsets[v];
+            skippedParent[v] = false;
+            if (articulation != nullptr) articulation[v] = false;
+        }
+        Stack path;
+        Stack open;
+        int time = 0, numBlocks = 0;
+        numBridges = 0;
+        for (int root = 0; root < V; root++) {
+            if (disc[root] >= 0) continue;
+            disc[root] = low[root] = time++;
+            parent[root] = -1;
+            path.push(root);
+            open.push(root);
+            int rootChildren = 0;
+            while (!path.isEmpty()) {
+                int u = path.peek();
+                if (cursor[u] < offsets[u + 1]) {
+                    int v = targets[cursor[u]++];
+                    if (v == u) continue;
+                    if (v == parent[u] && !skippedParent[u]) {
+                        skippedParent[u] = true;
+                        continue;
+                    }
+                    if (disc[v] < 0) {
+                        disc[v] = low[v] = time++;
+                        parent[v] = u;
+                        if (u == root) rootChildren++;
+                        path.push(v);
+                        open.push(v);
+                        STAT_PEAK(queuePeak, path.getSize());
+                    }
+                    else if (disc[v] < low[u]) {
+                        low[u] = disc[v];
+                    }
+                    continue;
+                }
+                path.pop();
+                int p = parent[u];
+                if (p < 0) continue;
+                if (low[u] < low[p]) low[p] = low[u];
+                if (low[u] >= disc[p]) {
+                    // p separates u's subtree from the rest: the open vertices from u up close a block
+                    int x;
+                    do {
+                        x = open.pop();
+                        blockOf[x] = numBlocks;
+                    } while (x != u);
+                    numBlocks++;
+                    if (articulation != nullptr && p != root) articulation[p] = true;
+                }
+                if (low[u] > disc[p]) {
+                    if (bridges != nullptr) {
+                        bridges[2 * numBridges] = p;
+                        bridges[2 * numBridges + 1] = u;
+                    }
+                    numBridges++;
+                }
+            }
+            open.pop(); // the root closes no block of its own
+            if (articulation != nullptr && rootChildren >= 2) articulation[root] = true;
+        }
+        STAT_ADD(verticesSettled, V);
+        STAT_ADD(edgesScanned, offsets[V]);
+        delete[] low;
+        delete[] parent;
+        delete[] cursor;
+        delete[] skippedParent;
+        return numBlocks;
+    }
+
+}
+    /**
+     * @brief Finds the articulation points (cut vertices): removing one disconnects its component.
+     *        Iterative Hopcroft-Tarjan with an explicit Stack, so deep graphs cannot overflow the call stack.
+     * 
+     * @param g The graph (undirected).
+     * @param articulation Output array of size V; true for articulation points.
+     * @return int The number of articulation points.
+     */
+    int Algorithms::articulationPoints(Graph& g, bool* articulation) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        int* disc = new int[V];
+        int* blockOf = new int[V];
+        int numBridges = 0;
+        hopcroftTarjan(V, csr.getOffsets(), csr.getTargets(), disc, blockOf, articulation, nullptr, numBridges);
+        int count = 0;
+        for (int v = 0; v < V; v++) {
+            if (articulation[v]) count++;
+        }
+        delete[] disc;
+        delete[] blockOf;
+        return count;
+    }
+
+    /**
+     * @brief Finds the bridges: edges whose removal disconnects their component. A parallel edge is never
+     *        a bridge. Iterative Hopcroft-Tarjan with an explicit Stack.
+     * 
+     * @param g The graph (undirected).
+     * @param endpoints Output array of size 2 * (V - 1) (bridges form a forest): bridge i joins
+     *        endpoints[2 * i] (the DFS parent) and endpoints[2 * i + 1].
+     * @return int The number of bridges.
+     */
+    int Algorithms::bridges(Graph& g, int* endpoints) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        int* disc = new int[V];
+        int* blockOf = new int[V];
+        int numBridges = 0;
+        hopcroftTarjan(V, csr.getOffsets(), csr.getTargets(), disc, blockOf, nullptr, endpoints, numBridges);
+        delete[] disc;
+        delete[] blockOf;
+        return numBridges;
+    }
+
+    /**
+     * @brief Splits the edges into biconnected components (blocks): maximal sets of edges in which any two
+     *        edges lie on a common simple cycle. A bridge is a block by itself, and articulation points are
+     *        the vertices shared by several blocks. Iterative Hopcroft-Tarjan with an explicit Stack;
+     *        each edge takes the block of the tree edge above its deeper endpoint.
+     * 
+     * @param g The graph (undirected).
+     * @param arcComponents Output array aligned with the arcs of CSRGraph(g) (size getNumArcs()); both
+     *        arcs of an edge get the same block id, self loops get -1.
+     * @return int The number of blocks.
+     */
+    int Algorithms::biconnectedComponents(Graph& g, int* arcComponents) {
+        STAT_RESET();
+        int V = g.getNumVertices();
+        CSRGraph csr(g);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* disc = new int[V];
+        int* blockOf = new int[V];
+        int numBridges = 0;
+        int numBlocks = hopcroftTarjan(V, offsets, targets, disc, blockOf, nullptr, nullptr, numBridges);
+        for (int u = 0; u < V; u++) {
+            for (long long e = offsets[u]; e < offsets[u + 1]; e++) {
+                int v = targets[e];
+                arcComponents[e] = u == v ? -1 : blockOf[disc[u] > disc[v] ? u : v];
+            }
+        }
+        delete[] disc;
+        delete[] blockOf;
+        return numBlocks;
+    }
+
+}
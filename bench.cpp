@@ -0,0 +1,648 @@
+// dor.cohen15@msmail.ariel.ac.il
+
+#include "graph.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/resource.h>
+#include <thread>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace graph;
+
+// ============================
+//         HARNESS SECTION
+// ============================
+
+static int reps = 7;            // timed repetitions per measurement
+static bool firstResult = true; // JSON separator state
+static volatile long long sink;  // results of the scan kernels, so they can't be optimized away
+
+/**
+ * @brief Small xorshift generator so runs are reproducible without <random>.
+ */
+struct Rng {
+    unsigned long long state;
+    Rng(unsigned long long seed) : state(seed * 2654435761ULL + 1) {}
+    unsigned long long next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+    int below(int bound) { return (int)(next() % (unsigned long long)bound); }
+};
+
+/**
+ * @brief Returns the peak resident set size of the process in kilobytes.
+ */
+static long peakRssKb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// ============================
+//         PERF SECTION
+// ============================
+
+static const int PERF_EVENTS = 5;
+static const char* perfNames[PERF_EVENTS] = {"cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses"};
+
+/**
+ * @brief Hardware counters read through Linux perf_event_open, counting user-space events of this thread
+ *        and of every thread it starts (inherit), so parallelFor workers are counted too. A read sums the
+ *        live child events and the counts folded in by exited ones; RESET does not clear the folded part,
+ *        so each run is measured as the difference of two reads.
+ *        Events the kernel or CPU refuses (containers, VMs, perf_event_paranoid) keep fd = -1
+ *        and are reported as null.
+ */
+struct PerfCounters {
+    int fds[PERF_EVENTS];
+    long long totals[PERF_EVENTS]; // summed over the runs of one measurement
+    long long starts[PERF_EVENTS]; // reading when the current run started
+
+    PerfCounters() {
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            fds[i] = -1;
+            totals[i] = 0;
+            starts[i] = 0;
+        }
+#ifdef __linux__
+        unsigned int types[PERF_EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                           PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE};
+        unsigned long long configs[PERF_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[i];
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.inherit = 1; // parallelFor spawns fresh threads per call
+            fds[i] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            if (fds[i] >= 0) close(fds[i]);
+        }
+#endif
+    }
+
+    void clearTotals() {
+        for (int i = 0; i < PERF_EVENTS; i++) totals[i] = 0;
+    }
+
+    void start() {
+#ifdef __linux__
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            if (fds[i] < 0) continue;
+            starts[i] = 0;
+            if (read(fds[i], &starts[i], sizeof(starts[i])) != (ssize_t)sizeof(starts[i])) starts[i] = 0;
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    void stop() {
+#ifdef __linux__
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            if (fds[i] < 0) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            long long value = 0;
+            if (read(fds[i], &value, sizeof(value)) == (ssize_t)sizeof(value)) totals[i] += value - starts[i];
+        }
+#endif
+    }
+};
+
+static PerfCounters* perf = nullptr; // opened once when --perf is given
+
+/**
+ * @brief Runs body `reps` times and returns the sorted wall-clock samples in nanoseconds.
+ */
+template <typename Body>
+static long long* measure(Body body) {
+    long long* samples = new long long[reps];
+    if (perf != nullptr) perf->clearTotals();
+    for (int r = 0; r < reps; r++) {
+        if (perf != nullptr) perf->start();
+        auto t0 = std::chrono::steady_clock::now();
+        body();
+        auto t1 = std::chrono::steady_clock::now();
+        if (perf != nullptr) perf->stop();
+        samples[r] = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+    for (int i = 1; i < reps; i++) { // insertion sort, reps is small
+        long long x = samples[i];
+        int j = i - 1;
+        while (j >= 0 && samples[j] > x) {
+            samples[j + 1] = samples[j];
+            j--;
+        }
+        samples[j + 1] = x;
+    }
+    return samples;
+}
+
+/**
+ * @brief Times body and prints one JSON record.
+ *        In --perf mode the record also carries the hardware counters of one run divided by `work`
+ *        (cycles per edge, L1 misses per edge, ...), null for counters that could not be opened.
+ *
+ * @param name Benchmark name (algorithm or container operation).
+ * @param family Input family ("container" for container benchmarks).
+ * @param vertices Number of vertices (or elements for containers).
+ * @param work Number of arcs scanned (or operations for containers), used for the throughput rate.
+ * @param body The code to time.
+ */
+template <typename Body>
+static void report(const char* name, const char* family, int vertices, long long work, Body body) {
+    long long* samples = measure(body);
+    long long median = samples[reps / 2];
+    int p99Index = (int)((99LL * reps + 99) / 100) - 1; // nearest-rank percentile
+    long long p99 = samples[p99Index < 0 ? 0 : p99Index];
+    double rate = median > 0 ? (double)work * 1e9 / (double)median : 0.0;
+    bool container = std::strcmp(family, "container") == 0;
+
+    std::cout << (firstResult ? "\n" : ",\n");
+    firstResult = false;
+    std::cout << "    {\"name\": \"" << name << "\", \"family\": \"" << family
+              << "\", \"vertices\": " << vertices
+              << ", \"" << (container ? "ops" : "arcs") << "\": " << work
+              << ", \"reps\": " << reps
+              << ", \"median_ns\": " << median
+              << ", \"p99_ns\": " << p99
+              << ", \"" << (container ? "ops_per_sec" : "edges_per_sec") << "\": " << (long long)rate
+              << ", \"peak_rss_kb\": " << peakRssKb();
+    if (perf != nullptr) {
+        std::cout << ", \"perf_per_" << (container ? "op" : "edge") << "\": {";
+        for (int i = 0; i < PERF_EVENTS; i++) {
+            std::cout << (i > 0 ? ", " : "") << "\"" << perfNames[i] << "\": ";
+            if (perf->fds[i] < 0 || work <= 0) {
+                std::cout << "null";
+            } else {
+                std::cout << (double)perf->totals[i] / reps / (double)work;
+            }
+        }
+        std::cout << "}";
+    }
+    std::cout << "}";
+    delete[] samples;
+}
+
+// ============================
+//       INPUT SECTION
+// ============================
+
+/**
+ * @brief Counts the arcs stored in the adjacency lists.
+ */
+static long long countArcs(Graph& g) {
+    long long arcs = 0;
+    for (int v = 0; v < g.getNumVertices(); v++) {
+        for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) arcs++;
+    }
+    return arcs;
+}
+
+// ============================
+//       SUITES SECTION
+// ============================
+
+/**
+ * @brief Times every Algorithms entry point on one input graph.
+ *        kruskal allocates a V*V edge buffer and sorts with selection sort, so it only runs on small inputs.
+ */
+static void benchAlgorithms(const char* family, Graph& g) {
+    int V = g.getNumVertices();
+    long long arcs = countArcs(g);
+
+    report("bfs", family, V, arcs, [&]() { Graph t = Algorithms::bfs(g, 0); });
+    report("dfs", family, V, arcs, [&]() { Graph t = Algorithms::dfs(g, 0); });
+    // 64 BFS searches: one by one, then sharing every adjacency scan
+    int sources[64];
+    for (int i = 0; i < 64; i++) sources[i] = (int)((long long)i * V / 64);
+    int* distances = new int[64LL * V];
+    report("bfs_x64", family, V, 64 * arcs, [&]() {
+        for (int i = 0; i < 64; i++) Graph t = Algorithms::bfs(g, sources[i]);
+    });
+    report("multi_source_bfs_64", family, V, 64 * arcs, [&]() { Algorithms::multiSourceBfs(g, sources, 64, distances); });
+    delete[] distances;
+    report("dijkstra", family, V, arcs, [&]() { Graph t = Algorithms::dijkstra(g, 0); });
+    int* spfaDistances = new int[V];
+    report("bellman_ford_spfa", family, V, arcs, [&]() { Algorithms::bellmanFord(g, 0, spfaDistances); });
+    delete[] spfaDistances;
+    report("prim", family, V, arcs, [&]() { Graph t = Algorithms::prim(g); });
+    if (V <= 2000) {
+        report("kruskal", family, V, arcs, [&]() { Graph t = Algorithms::kruskal(g); });
+        int* matrix = new int[(long long)V * V];
+        long long cubic = (long long)V * V * V;
+        report("floyd_warshall", family, V, cubic, [&]() { Algorithms::floydWarshall(g, matrix, 1); });
+        report("floyd_warshall_t4", family, V, cubic, [&]() { Algorithms::floydWarshall(g, matrix, 4); });
+        // untiled reference: the same min-plus work in plain k, i, j order
+        report("floyd_warshall_untiled", family, V, cubic, [&]() {
+            for (long long i = 0; i < (long long)V * V; i++) matrix[i] = 2147483647;
+            for (int v = 0; v < V; v++) {
+                matrix[(long long)v * V + v] = 0;
+                for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) {
+                    if (n->weight < matrix[(long long)v * V + n->vertex]) matrix[(long long)v * V + n->vertex] = n->weight;
+                }
+            }
+            for (int k = 0; k < V; k++) {
+                for (int i = 0; i < V; i++) {
+                    long long dik = matrix[(long long)i * V + k];
+                    if (dik == 2147483647) continue;
+                    for (int j = 0; j < V; j++) {
+                        long long through = dik + matrix[(long long)k * V + j];
+                        if (through < matrix[(long long)i * V + j]) matrix[(long long)i * V + j] = (int)through;
+                    }
+                }
+            }
+        });
+        report("all_pairs_dijkstra", family, V, V * arcs, [&]() { Algorithms::allPairsDijkstra(g, matrix, 1); });
+        report("all_pairs_dijkstra_t4", family, V, V * arcs, [&]() { Algorithms::allPairsDijkstra(g, matrix, 4); });
+        report("johnson", family, V, V * arcs, [&]() { Algorithms::johnson(g, matrix, 1); });
+        delete[] matrix;
+    }
+    // pure adjacency scans: the same work over the three storage layouts
+    report("scan_linked_list", family, V, arcs, [&]() {
+        Node** adjList = g.getAdjList();
+        long long checksum = 0;
+        for (int v = 0; v < V; v++) {
+            for (Node* n = adjList[v]; n != nullptr; n = n->next) checksum += n->vertex + n->weight;
+        }
+        sink = checksum;
+    });
+    CSRGraph csr(g);
+    report("scan_csr", family, V, arcs, [&]() {
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* weights = csr.getWeights();
+        long long checksum = 0;
+        for (long long i = 0; i < offsets[V]; i++) checksum += targets[i] + weights[i];
+        sink = checksum;
+    });
+    report("count_triangles", family, V, arcs, [&]() { Algorithms::countTriangles(g); });
+    {
+        // the family oriented from lower to higher id: a DAG with the same shape
+        Graph dag(V);
+        for (int u = 0; u < V; u++) {
+            for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+                if (n->vertex > u) dag.addDirectedEdge(u, n->vertex, n->weight);
+            }
+        }
+        long long dagArcs = countArcs(dag);
+        int* order = new int[V];
+        report("topological_sort", family, V, dagArcs, [&]() { Algorithms::topologicalSort(dag, order, 1); });
+        report("topological_sort_levels_t4", family, V, dagArcs, [&]() { Algorithms::topologicalSort(dag, order, 4); });
+        report("dag_shortest_paths", family, V, dagArcs, [&]() { Algorithms::dagShortestPaths(dag, 0, order); });
+        report("dijkstra_on_dag", family, V, dagArcs, [&]() { Graph t = Algorithms::dijkstra(dag, 0); });
+        delete[] order;
+    }
+    report("maxflow_dinic", family, V, arcs, [&]() { Algorithms::maxFlow(g, 0, V - 1, MAXFLOW_DINIC); });
+    report("maxflow_push_relabel", family, V, arcs, [&]() { Algorithms::maxFlow(g, 0, V - 1, MAXFLOW_PUSH_RELABEL); });
+    double* ranks = new double[V];
+    report("pagerank_20_iterations", family, V, 20 * arcs, [&]() { Algorithms::pagerank(g, ranks, 0.85, 0.0, 20, 1); });
+    report("pagerank_20_iterations_t4", family, V, 20 * arcs, [&]() { Algorithms::pagerank(g, ranks, 0.85, 0.0, 20, 4); });
+    if (V <= 2000) {
+        report("betweenness_exact", family, V, V * arcs, [&]() { Algorithms::betweenness(g, ranks); });
+    }
+    report("betweenness_sampled_64", family, V, 64 * arcs, [&]() { Algorithms::betweenness(g, ranks, false, 64); });
+    report("betweenness_sampled_64_weighted_t4", family, V, 64 * arcs, [&]() { Algorithms::betweenness(g, ranks, true, 64, 4); });
+    delete[] ranks;
+    report("csr_build", family, V, arcs, [&]() { CSRGraph csr(g); });
+
+    int* labels = new int[V];
+    report("connected_components", family, V, arcs, [&]() { Algorithms::connectedComponents(g, labels, 1); });
+    report("connected_components_afforest_t4", family, V, arcs, [&]() { Algorithms::connectedComponents(g, labels, 4); });
+    report("strongly_connected_components", family, V, arcs, [&]() { Graph dag = Algorithms::stronglyConnectedComponents(g, labels, 1); });
+    report("strongly_connected_components_coloring_t4", family, V, arcs, [&]() { Graph dag = Algorithms::stronglyConnectedComponents(g, labels, 4); });
+    report("core_numbers", family, V, arcs, [&]() { Algorithms::coreNumbers(g, labels, 1); });
+    report("core_numbers_peeling_t4", family, V, arcs, [&]() { Algorithms::coreNumbers(g, labels, 4); });
+    report("coloring_largest_first", family, V, arcs, [&]() { Algorithms::greedyColoring(g, labels, COLORING_LARGEST_FIRST); });
+    report("coloring_smallest_last", family, V, arcs, [&]() { Algorithms::greedyColoring(g, labels, COLORING_SMALLEST_LAST); });
+    report("coloring_jones_plassmann_t4", family, V, arcs, [&]() { Algorithms::greedyColoring(g, labels, COLORING_JONES_PLASSMANN, 4); });
+    report("louvain", family, V, arcs, [&]() { Algorithms::louvain(g, labels); });
+    report("louvain_t4", family, V, arcs, [&]() { Algorithms::louvain(g, labels, nullptr, 32, 4); });
+    report("label_propagation", family, V, arcs, [&]() { Algorithms::labelPropagation(g, labels); });
+    report("label_propagation_t4", family, V, arcs, [&]() { Algorithms::labelPropagation(g, labels, 20, 4); });
+    int* blocks = new int[arcs];
+    report("biconnected_components", family, V, arcs, [&]() { Algorithms::biconnectedComponents(g, blocks); });
+    delete[] blocks;
+    delete[] labels;
+
+    CompressedGraph cg(g);
+    int* rowVertices = new int[cg.getMaxDegree()];
+    int* rowWeights = new int[cg.getMaxDegree()];
+    report("scan_compressed", family, V, arcs, [&]() {
+        long long checksum = 0;
+        for (int v = 0; v < V; v++) {
+            int count = cg.decodeNeighbors(v, rowVertices, rowWeights);
+            for (int i = 0; i < count; i++) checksum += rowVertices[i] + rowWeights[i];
+        }
+        sink = checksum;
+    });
+    delete[] rowVertices;
+    delete[] rowWeights;
+    report("compressed_build", family, V, arcs, [&]() { CompressedGraph c(g); });
+    int* edgeSources = new int[arcs / 2 + 1];
+    int* edgeTargets = new int[arcs / 2 + 1];
+    int* edgeWeights = new int[arcs / 2 + 1];
+    long long numEdges = 0;
+    for (int u = 0; u < V; u++) {
+        for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+            if (n->vertex <= u) continue; // each edge once; the generators make no loops
+            edgeSources[numEdges] = u;
+            edgeTargets[numEdges] = n->vertex;
+            edgeWeights[numEdges++] = n->weight;
+        }
+    }
+    report("compressed_build_from_edges", family, V, arcs, [&]() {
+        CompressedGraph c(V, edgeSources, edgeTargets, edgeWeights, numEdges);
+    });
+    delete[] edgeSources;
+    delete[] edgeTargets;
+    delete[] edgeWeights;
+    report("compressed_bfs", family, V, arcs, [&]() { Graph t = Algorithms::bfs(cg, 0); });
+    report("compressed_dfs", family, V, arcs, [&]() { Graph t = Algorithms::dfs(cg, 0); });
+
+    // relabel, then traverse the relabeled graph to compare locality
+    ReorderStrategy strategies[4] = {REORDER_RCM, REORDER_DEGREE, REORDER_BFS, REORDER_GORDER};
+    const char* names[4] = {"rcm", "degree", "bfs", "gorder"};
+    int* perm = new int[V];
+    for (int s = 0; s < 4; s++) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "reorder_%s", names[s]);
+        report(name, family, V, arcs, [&]() { Graph h = Algorithms::reorder(g, strategies[s], perm); });
+        Graph h = Algorithms::reorder(g, strategies[s], perm);
+        std::snprintf(name, sizeof(name), "bfs_after_%s", names[s]);
+        report(name, family, V, arcs, [&]() { Graph t = Algorithms::bfs(h, perm[0]); });
+    }
+    delete[] perm;
+}
+
+/**
+ * @brief Times Hopcroft-Karp against the same matching solved as a unit-capacity max flow,
+ *        on a random bipartite graph with n / 2 vertices per side and 4n edges.
+ */
+static void benchMatching(int n) {
+    int half = n / 2;
+    Graph g(n);
+    Graph flow(n + 2);
+    Rng rng(42);
+    for (int i = 0; i < 4 * n; i++) {
+        int u = rng.below(half);
+        int v = half + rng.below(half);
+        g.addEdge(u, v, 1);
+        flow.addDirectedEdge(u, v, 1);
+    }
+    for (int u = 0; u < half; u++) flow.addDirectedEdge(n, u, 1);
+    for (int v = half; v < n; v++) flow.addDirectedEdge(v, n + 1, 1);
+    long long arcs = countArcs(g);
+    int* mate = new int[n];
+    report("hopcroft_karp", "bipartite", n, arcs, [&]() { Algorithms::maxBipartiteMatching(g, mate); });
+    report("matching_via_maxflow_dinic", "bipartite", n, arcs, [&]() { Algorithms::maxFlow(flow, n, n + 1); });
+    delete[] mate;
+}
+
+/**
+ * @brief Times every generator with 1, 4 and all hardware threads on about n vertices and 8n arcs
+ *        (the graph is the same for every thread count).
+ */
+static void benchGenerators(int n, int rmatScale) {
+    int side = 1;
+    while ((side + 1) * (side + 1) <= n) side++;
+    int hardware = (int)std::thread::hardware_concurrency();
+    int threadCounts[3] = {1, 4, hardware};
+    for (int c = 0; c < 3; c++) {
+        int threads = threadCounts[c];
+        if (threads < 1 || (c == 2 && threads == 4) || (c == 2 && threads == 1)) continue;
+        char name[64];
+        std::snprintf(name, sizeof(name), "generate_t%d", threads);
+        {
+            Graph g = Generators::erdosRenyi(n, 8.0 / n, 1, 100, 42, threads);
+            report(name, "erdos_renyi", n, countArcs(g), [&]() { Generators::erdosRenyi(n, 8.0 / n, 1, 100, 42, threads); });
+        }
+        {
+            Graph g = Generators::rmat(rmatScale, 4, 0.57, 0.19, 0.19, 1, 100, 42, threads);
+            report(name, "rmat", g.getNumVertices(), countArcs(g), [&]() {
+                Generators::rmat(rmatScale, 4, 0.57, 0.19, 0.19, 1, 100, 42, threads);
+            });
+        }
+        {
+            Graph g = Generators::barabasiAlbert(n, 4, 1, 100, 42, threads);
+            report(name, "barabasi_albert", n, countArcs(g), [&]() { Generators::barabasiAlbert(n, 4, 1, 100, 42, threads); });
+        }
+        {
+            Graph g = Generators::grid(side, side, 1, 100, 42, threads);
+            report(name, "grid", side * side, countArcs(g), [&]() { Generators::grid(side, side, 1, 100, 42, threads); });
+        }
+        {
+            double radius = std::sqrt(8.0 / (3.14159265358979 * n));
+            Graph g = Generators::randomGeometric(n, radius, 1, 100, 42, threads);
+            report(name, "geometric", n, countArcs(g), [&]() { Generators::randomGeometric(n, radius, 1, 100, 42, threads); });
+        }
+    }
+}
+
+/**
+ * @brief Times both max-flow solvers on a DIMACS max-flow file ("p max n m", "n id s|t", "a u v cap",
+ *        1-based vertex ids, "c" comment lines).
+ */
+static void benchDimacs(const char* path) {
+    std::FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        std::fprintf(stderr, "cannot open %s\n", path);
+        return;
+    }
+    char line[256];
+    Graph* g = nullptr;
+    int source = -1, sinkVertex = -1;
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        int n = 0, u = 0, v = 0, cap = 0;
+        long long m = 0;
+        char kind = 0;
+        if (line[0] == 'p' && std::sscanf(line, "p max %d %lld", &n, &m) == 2 && g == nullptr) {
+            g = new Graph(n);
+        }
+        else if (line[0] == 'n' && std::sscanf(line, "n %d %c", &u, &kind) == 2) {
+            if (kind == 's') source = u - 1;
+            else if (kind == 't') sinkVertex = u - 1;
+        }
+        else if (line[0] == 'a' && g != nullptr && std::sscanf(line, "a %d %d %d", &u, &v, &cap) == 3) {
+            g->addDirectedEdge(u - 1, v - 1, cap);
+        }
+    }
+    std::fclose(file);
+    if (g == nullptr || source < 0 || sinkVertex < 0) {
+        std::fprintf(stderr, "%s is not a DIMACS max-flow file\n", path);
+        delete g;
+        return;
+    }
+    int V = g->getNumVertices();
+    long long arcs = countArcs(*g);
+    report("maxflow_dinic", "dimacs", V, arcs, [&]() { Algorithms::maxFlow(*g, source, sinkVertex, MAXFLOW_DINIC); });
+    report("maxflow_push_relabel", "dimacs", V, arcs, [&]() { Algorithms::maxFlow(*g, source, sinkVertex, MAXFLOW_PUSH_RELABEL); });
+    delete g;
+}
+
+/**
+ * @brief Times the containers with n operations each.
+ */
+static void benchContainers(int n) {
+    report("queue_enqueue_dequeue", "container", n, 2LL * n, [&]() {
+        Queue q(n);
+        for (int i = 0; i < n; i++) q.enqueue(i);
+        while (!q.isEmpty()) q.dequeue();
+    });
+    report("stack_push_pop", "container", n, 2LL * n, [&]() {
+        Stack s(n);
+        for (int i = 0; i < n; i++) s.push(i);
+        while (!s.isEmpty()) s.pop();
+    });
+    report("queue_grow_enqueue_dequeue", "container", n, 2LL * n, [&]() {
+        Queue q;
+        for (int i = 0; i < n; i++) q.enqueue(i);
+        while (!q.isEmpty()) q.dequeue();
+    });
+    report("queue_ring_steady", "container", n, 2LL * n, [&]() {
+        Queue q;
+        for (int i = 0; i < 8; i++) q.enqueue(i);
+        for (int i = 0; i < n; i++) {
+            q.enqueue(q.dequeue() + i);
+        }
+    });
+    report("stack_grow_push_pop", "container", n, 2LL * n, [&]() {
+        Stack s;
+        for (int i = 0; i < n; i++) s.push(i);
+        while (!s.isEmpty()) s.pop();
+    });
+    report("priority_queue_insert_extract", "container", n, 2LL * n, [&]() {
+        Rng rng(7);
+        PriorityQueue pq(n);
+        for (int i = 0; i < n; i++) pq.insert(i, rng.below(1000000));
+        while (!pq.isEmpty()) pq.extractMin();
+    });
+    int small = n < 4096 ? n : 4096; // decreaseKey is a linear scan
+    report("priority_queue_decrease_key", "container", small, small, [&]() {
+        PriorityQueue pq(small);
+        for (int i = 0; i < small; i++) pq.insert(i, 1000000 + i);
+        for (int i = 0; i < small; i++) pq.decreaseKey(i, small - i);
+    });
+    report("union_find_unite_find", "container", n, 2LL * n, [&]() {
+        Rng rng(11);
+        UnionFind uf(n);
+        for (int i = 0; i < n; i++) uf.unite(rng.below(n), rng.below(n));
+        for (int i = 0; i < n; i++) uf.find(i);
+    });
+
+    // same operation mix on the lock-free structure, split over 1 and 4 threads
+    int* pairs = new int[2 * n];
+    Rng rng(11);
+    for (int i = 0; i < 2 * n; i++) pairs[i] = rng.below(n);
+    int threadCounts[2] = {1, 4};
+    for (int c = 0; c < 2; c++) {
+        int threads = threadCounts[c];
+        char name[64];
+        std::snprintf(name, sizeof(name), "concurrent_union_find_unite_find_t%d", threads);
+        report(name, "container", n, 2LL * n, [&]() {
+            ConcurrentUnionFind cuf(n);
+            std::thread* workers = new std::thread[threads];
+            for (int t = 0; t < threads; t++) {
+                workers[t] = std::thread([&, t]() {
+                    for (int i = t; i < n; i += threads) cuf.unite(pairs[2 * i], pairs[2 * i + 1]);
+                    for (int i = t; i < n; i += threads) cuf.find(i);
+                });
+            }
+            for (int t = 0; t < threads; t++) workers[t].join();
+            delete[] workers;
+        });
+    }
+    delete[] pairs;
+}
+
+/**
+ * @brief Benchmark driver. Prints one JSON document to stdout.
+ *        Usage: ./bench [--scale K] [--reps R] [--perf]
+ *        Every graph family is generated with about 1024, 4096 and 16384 vertices multiplied by K
+ *        and weights in [1, 100].
+ */
+int main(int argc, char** argv) {
+    int scale = 1;
+    bool profile = false;
+    const char* dimacs = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--scale") == 0 && i + 1 < argc) scale = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--reps") == 0 && i + 1 < argc) reps = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--perf") == 0) profile = true;
+        else if (std::strcmp(argv[i], "--dimacs") == 0 && i + 1 < argc) dimacs = argv[++i];
+    }
+    if (scale < 1) scale = 1;
+    if (reps < 1) reps = 1;
+    if (profile) perf = new PerfCounters();
+
+    std::cout << "{\"scale\": " << scale << ", \"perf\": " << (profile ? "true" : "false") << ", \"results\": [";
+    if (dimacs != nullptr) {
+        benchDimacs(dimacs); // only the given instance
+        std::cout << "\n]}" << std::endl;
+        delete perf;
+        return 0;
+    }
+    for (int s = 10; s <= 14; s += 2) {
+        int rmatScale = s;
+        while ((1 << (rmatScale - s)) < scale) rmatScale++;
+        int n = (1 << s) * scale;
+        int side = 1;
+        while ((side + 1) * (side + 1) <= n) side++;
+        {
+            Graph g = Generators::erdosRenyi(n, 8.0 / n, 1, 100, 42);
+            benchAlgorithms("erdos_renyi", g);
+        }
+        {
+            Graph g = Generators::rmat(rmatScale, 4, 0.57, 0.19, 0.19, 1, 100, 42);
+            benchAlgorithms("rmat", g);
+        }
+        {
+            Graph g = Generators::barabasiAlbert(n, 4, 1, 100, 42);
+            benchAlgorithms("barabasi_albert", g);
+        }
+        {
+            Graph g = Generators::grid(side, side, 1, 100, 42);
+            benchAlgorithms("grid", g);
+        }
+        {
+            Graph g = Generators::randomGeometric(n, std::sqrt(8.0 / (3.14159265358979 * n)), 1, 100, 42);
+            benchAlgorithms("geometric", g);
+        }
+        {
+            Graph g = Generators::grid(1, n, 1, 100, 42);
+            benchAlgorithms("chain", g);
+        }
+        benchMatching(n);
+        benchGenerators(n, rmatScale);
+    }
+    for (int s = 14; s <= 18; s += 2) {
+        benchContainers((1 << s) * scale);
+    }
+    std::cout << "\n]}" << std::endl;
+    delete perf;
+    return 0;
+}
@@ -0,0 +1,514 @@
+// dor.cohen15@msmail.ariel.ac.il
+
+#include "graph.hpp"
+#include "parallel.hpp"
+#include <cmath>
+using namespace graph;
+
+// ============================
+//         RANDOM SECTION
+// ============================
+
+namespace {
+
+    /**
+     * @brief SplitMix64 generator: tiny state, good statistical quality, reproducible by seed.
+     */
+    struct SplitMix {
+        unsigned long long state;
+
+        SplitMix(unsigned long long seed) : state(seed) {}
+
+        unsigned long long next() {
+            unsigned long long z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        // uniform double in [0, 1)
+        double uniform() {
+            return (double)(next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        // uniform int in [0, bound)
+        int below(int bound) {
+            return (int)(next() % (unsigned long long)bound);
+        }
+
+        // uniform int in [lo, hi]
+        int between(int lo, int hi) {
+            return lo + (int)(next() % (unsigned long long)((long long)hi - lo + 1));
+        }
+    };
+
+    void checkWeights(int minWeight, int maxWeight) {
+        if (minWeight > maxWeight) {
+            throw std::invalid_argument("minWeight must not exceed maxWeight.");
+        }
+    }
+
+    // vertices (or R-MAT edges) per generation block; fixed, so the graph does not depend on numThreads
+    const int BLOCK = 1 << 14;
+
+    /**
+     * @brief Independent stream of one generation block, derived from the seed and the block index.
+     */
+    SplitMix blockStream(unsigned long long seed, long long block) {
+        SplitMix mixer(seed ^ ((unsigned long long)block * 0xD1B54A32D192ED03ULL));
+        return SplitMix(mixer.next());
+    }
+
+    /**
+     * @brief Growable edge list of one generation block.
+     */
+    struct EdgeBlock {
+        int* sources;
+        int* targets;
+        int* weights;
+        long long count;
+        long long capacity;
+
+        EdgeBlock() : sources(nullptr), targets(nullptr), weights(nullptr), count(0), capacity(0) {}
+
+        ~EdgeBlock() {
+            delete[] sources;
+            delete[] targets;
+            delete[] weights;
+        }
+
+        void add(int u, int v, int weight) {
+            if (count == capacity) {
+                long long grown = capacity < 16 ? 16 : 2 * capacity;
+                int* s = new int[grown];
+                int* t = new int[grown];
+                int* w = new int[grown];
+                for (long long i = 0; i < count; i++) {
+                    s[i] = sources[i];
+                    t[i] = targets[i];
+                    w[i] = weights[i];
+                }
+                delete[] sources;
+                delete[] targets;
+                delete[] weights;
+                sources = s;
+                targets = t;
+                weights = w;
+                capacity = grown;
+            }
+            sources[count] = u;
+            targets[count] = v;
+            weights[count++] = weight;
+        }
+    };
+
+    /**
+     * @brief Adds the edges of all blocks, in block order, as undirected edges of g.
+     *        Each thread owns a range of vertices. The arcs are first bucketed by owner (a count per
+     *        block and owner, a prefix sum, then a scatter that keeps the edge order), so every thread
+     *        reads only its own bucket and pushes onto its own lists without locking. The lists come
+     *        out identical to sequential addEdge calls for any number of threads.
+     */
+    void insertEdges(Graph& g, EdgeBlock* blocks, int numBlocks, int numThreads) {
+        int V = g.getNumVertices();
+        if (numThreads < 1) numThreads = 1;
+        if (V == 0 || numBlocks == 0) return;
+        int span = (int)(((long long)V + numThreads - 1) / numThreads);
+        int owners = (V + span - 1) / span;
+        if (owners == 1) { // a single bucket would just copy the blocks
+            for (int b = 0; b < numBlocks; b++) {
+                for (long long i = 0; i < blocks[b].count; i++) {
+                    g.addDirectedEdge(blocks[b].sources[i], blocks[b].targets[i], blocks[b].weights[i]);
+                    g.addDirectedEdge(blocks[b].targets[i], blocks[b].sources[i], blocks[b].weights[i]);
+                }
+            }
+            return;
+        }
+
+        // counts[b * owners + t]: arcs of block b owned by thread t, turned into scatter offsets below
+        long long* counts = new long long[(long long)numBlocks * owners]();
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int b = begin; b < end; b++) {
+                long long* row = counts + (long long)b * owners;
+                for (long long i = 0; i < blocks[b].count; i++) {
+                    row[blocks[b].sources[i] / span]++;
+                    row[blocks[b].targets[i] / span]++;
+                }
+            }
+        }, 1);
+        long long* bucketStart = new long long[owners + 1];
+        long long total = 0;
+        for (int t = 0; t < owners; t++) {
+            bucketStart[t] = total;
+            for (int b = 0; b < numBlocks; b++) {
+                long long c = counts[(long long)b * owners + t];
+                counts[(long long)b * owners + t] = total;
+                total += c;
+            }
+        }
+        bucketStart[owners] = total;
+
+        int* arcSources = new int[total];
+        int* arcTargets = new int[total];
+        int* arcWeights = new int[total];
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int b = begin; b < end; b++) {
+                long long* next = counts + (long long)b * owners;
+                for (long long i = 0; i < blocks[b].count; i++) {
+                    int u = blocks[b].sources[i], v = blocks[b].targets[i], w = blocks[b].weights[i];
+                    long long p = next[u / span]++;
+                    arcSources[p] = u;
+                    arcTargets[p] = v;
+                    arcWeights[p] = w;
+                    p = next[v / span]++;
+                    arcSources[p] = v;
+                    arcTargets[p] = u;
+                    arcWeights[p] = w;
+                }
+            }
+        }, 1);
+        delete[] counts;
+
+        parallelFor(owners, numThreads, [&](int begin, int end, int) {
+            for (int t = begin; t < end; t++) {
+                for (long long p = bucketStart[t]; p < bucketStart[t + 1]; p++) {
+                    g.addDirectedEdge(arcSources[p], arcTargets[p], arcWeights[p]);
+                }
+            }
+        }, 1);
+        delete[] bucketStart;
+        delete[] arcSources;
+        delete[] arcTargets;
+        delete[] arcWeights;
+    }
+
+}
+
+namespace graph {
+
+// ============================
+//      ERDOS-RENYI SECTION
+// ============================
+    /**
+     * @brief Generates a G(n, p) random graph: every pair of distinct vertices is an edge with probability p.
+     *        Uses geometric skipping (Batagelj-Brandes), so the cost is O(V + E) instead of O(V^2).
+     *        Blocks of rows (pairs (v, w) with w < v) are drawn in parallel, each from its own stream.
+     *
+     * @param vertices Number of vertices.
+     * @param p Edge probability, in [0, 1].
+     * @param minWeight Smallest edge weight.
+     * @param maxWeight Largest edge weight (weights are uniform in [minWeight, maxWeight]).
+     * @param seed Random seed.
+     * @param numThreads Number of threads (the graph is the same for any value).
+     * @return Graph The generated graph.
+     */
+    Graph Generators::erdosRenyi(int vertices, double p, int minWeight, int maxWeight, unsigned long long seed,
+                                 int numThreads) {
+        if (vertices < 0 || p < 0.0 || p > 1.0) {
+            throw std::invalid_argument("Invalid Erdos-Renyi parameters.");
+        }
+        checkWeights(minWeight, maxWeight);
+        Graph g(vertices);
+        if (p == 0.0) return g;
+        int numBlocks = (int)(((long long)vertices + BLOCK - 1) / BLOCK);
+        EdgeBlock* blocks = new EdgeBlock[numBlocks];
+        double logQ = std::log(1.0 - p);
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int b = begin; b < end; b++) {
+                SplitMix rng = blockStream(seed, b);
+                long long rowEnd = (long long)(b + 1) * BLOCK < vertices ? (long long)(b + 1) * BLOCK : vertices;
+                long long v = (long long)b * BLOCK, w = -1;
+                while (v < rowEnd) {
+                    long long skip = 0;
+                    if (p < 1.0) {
+                        skip = (long long)std::floor(std::log(1.0 - rng.uniform()) / logQ);
+                    }
+                    w += 1 + skip;
+                    while (w >= v && v < rowEnd) {
+                        w -= v;
+                        v++;
+                    }
+                    if (v < rowEnd) {
+                        blocks[b].add((int)v, (int)w, rng.between(minWeight, maxWeight));
+                    }
+                }
+            }
+        }, 1);
+        insertEdges(g, blocks, numBlocks, numThreads);
+        delete[] blocks;
+        return g;
+    }
+
+// ============================
+//         R-MAT SECTION
+// ============================
+    /**
+     * @brief Generates an R-MAT (recursive Kronecker) graph with 2^scale vertices and edgeFactor * 2^scale edges.
+     *        Each edge descends the adjacency matrix quadrant by quadrant with probabilities a, b, c and 1-a-b-c,
+     *        which yields the skewed degree distribution of real-world networks. Self loops are dropped,
+     *        parallel edges are kept. Edges are drawn in parallel blocks, each from its own stream.
+     *
+     * @param scale log2 of the number of vertices (0..30).
+     * @param edgeFactor Edges drawn per vertex.
+     * @param a Probability of the top-left quadrant.
+     * @param b Probability of the top-right quadrant.
+     * @param c Probability of the bottom-left quadrant.
+     * @param minWeight Smallest edge weight.
+     * @param maxWeight Largest edge weight.
+     * @param seed Random seed.
+     * @param numThreads Number of threads (the graph is the same for any value).
+     * @return Graph The generated graph.
+     */
+    Graph Generators::rmat(int scale, int edgeFactor, double a, double b, double c,
+                           int minWeight, int maxWeight, unsigned long long seed, int numThreads) {
+        if (scale < 0 || scale > 30 || edgeFactor < 0 || a < 0.0 || b < 0.0 || c < 0.0 || a + b + c > 1.0) {
+            throw std::invalid_argument("Invalid R-MAT parameters.");
+        }
+        checkWeights(minWeight, maxWeight);
+        int vertices = 1 << scale;
+        Graph g(vertices);
+        long long edges = (long long)edgeFactor * vertices;
+        int numBlocks = (int)((edges + BLOCK - 1) / BLOCK);
+        EdgeBlock* blocks = new EdgeBlock[numBlocks];
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int k = begin; k < end; k++) {
+                SplitMix rng = blockStream(seed, k);
+                long long last = (long long)(k + 1) * BLOCK < edges ? (long long)(k + 1) * BLOCK : edges;
+                for (long long e = (long long)k * BLOCK; e < last; e++) {
+                    int src = 0, dst = 0;
+                    for (int bit = scale - 1; bit >= 0; bit--) {
+                        double r = rng.uniform();
+                        if (r < a) {
+                            // top-left: both bits stay 0
+                        } else if (r < a + b) {
+                            dst |= 1 << bit;
+                        } else if (r < a + b + c) {
+                            src |= 1 << bit;
+                        } else {
+                            src |= 1 << bit;
+                            dst |= 1 << bit;
+                        }
+                    }
+                    if (src != dst) {
+                        blocks[k].add(src, dst, rng.between(minWeight, maxWeight));
+                    }
+                }
+            }
+        }, 1);
+        insertEdges(g, blocks, numBlocks, numThreads);
+        delete[] blocks;
+        return g;
+    }
+
+// ============================
+//    BARABASI-ALBERT SECTION
+// ============================
+    /**
+     * @brief Generates a Barabasi-Albert preferential-attachment graph.
+     *        Starts from a clique on edgesPerVertex + 1 vertices; every later vertex connects to
+     *        edgesPerVertex distinct earlier vertices chosen proportionally to their degree
+     *        (by sampling a uniform endpoint of the edges created so far).
+     *        Every pick depends on all earlier ones, so edges are drawn sequentially; only the
+     *        insertion into the adjacency lists runs in parallel.
+     *
+     * @param vertices Number of vertices.
+     * @param edgesPerVertex Edges added with every new vertex (at least 1, less than vertices).
+     * @param minWeight Smallest edge weight.
+     * @param maxWeight Largest edge weight.
+     * @param seed Random seed.
+     * @param numThreads Number of threads (the graph is the same for any value).
+     * @return Graph The generated graph.
+     */
+    Graph Generators::barabasiAlbert(int vertices, int edgesPerVertex, int minWeight, int maxWeight, unsigned long long seed,
+                                     int numThreads) {
+        if (edgesPerVertex < 1 || edgesPerVertex >= vertices) {
+            throw std::invalid_argument("Invalid Barabasi-Albert parameters.");
+        }
+        checkWeights(minWeight, maxWeight);
+        Graph g(vertices);
+        SplitMix rng(seed);
+        int m = edgesPerVertex;
+        EdgeBlock edges;
+
+        // every edge contributes both endpoints, so a uniform pick is degree-proportional
+        long long capacity = (long long)m * (m + 1) + 2LL * m * (vertices - m - 1);
+        int* endpoints = new int[capacity];
+        long long count = 0;
+        for (int u = 0; u <= m; u++) {
+            for (int v = u + 1; v <= m; v++) {
+                edges.add(u, v, rng.between(minWeight, maxWeight));
+                endpoints[count++] = u;
+                endpoints[count++] = v;
+            }
+        }
+
+        int* chosen = new int[m];
+        for (int v = m + 1; v < vertices; v++) {
+            int picked = 0;
+            while (picked < m) {
+                int target = endpoints[rng.next() % (unsigned long long)count];
+                bool duplicate = false;
+                for (int i = 0; i < picked; i++) {
+                    if (chosen[i] == target) duplicate = true;
+                }
+                if (!duplicate) chosen[picked++] = target;
+            }
+            for (int i = 0; i < m; i++) {
+                edges.add(v, chosen[i], rng.between(minWeight, maxWeight));
+                endpoints[count++] = v;
+                endpoints[count++] = chosen[i];
+            }
+        }
+
+        delete[] chosen;
+        delete[] endpoints;
+        insertEdges(g, &edges, 1, numThreads);
+        return g;
+    }
+
+// ============================
+//         GRID SECTION
+// ============================
+    /**
+     * @brief Generates a rows x cols 4-neighbor lattice, a simple stand-in for road networks
+     *        (bounded degree, large diameter). Vertex (r, c) is r * cols + c. A 1 x n grid is a path.
+     *        Blocks of rows draw their weights in parallel, each from its own stream.
+     *
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @param minWeight Smallest edge weight.
+     * @param maxWeight Largest edge weight.
+     * @param seed Random seed.
+     * @param numThreads Number of threads (the graph is the same for any value).
+     * @return Graph The generated graph.
+     */
+    Graph Generators::grid(int rows, int cols, int minWeight, int maxWeight, unsigned long long seed, int numThreads) {
+        if (rows < 0 || cols < 0 || (long long)rows * cols > 2147483647LL) {
+            throw std::invalid_argument("Invalid grid dimensions.");
+        }
+        checkWeights(minWeight, maxWeight);
+        Graph g(rows * cols);
+        if (rows == 0 || cols == 0) return g;
+        int rowsPerBlock = cols < BLOCK ? BLOCK / cols : 1;
+        int numBlocks = (rows + rowsPerBlock - 1) / rowsPerBlock;
+        EdgeBlock* blocks = new EdgeBlock[numBlocks];
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int k = begin; k < end; k++) {
+                SplitMix rng = blockStream(seed, k);
+                int lastRow = (long long)(k + 1) * rowsPerBlock < rows ? (k + 1) * rowsPerBlock : rows;
+                for (int r = k * rowsPerBlock; r < lastRow; r++) {
+                    for (int c = 0; c < cols; c++) {
+                        int v = r * cols + c;
+                        if (c + 1 < cols) blocks[k].add(v, v + 1, rng.between(minWeight, maxWeight));
+                        if (r + 1 < rows) blocks[k].add(v, v + cols, rng.between(minWeight, maxWeight));
+                    }
+                }
+            }
+        }, 1);
+        insertEdges(g, blocks, numBlocks, numThreads);
+        delete[] blocks;
+        return g;
+    }
+
+// ============================
+//    RANDOM GEOMETRIC SECTION
+// ============================
+    /**
+     * @brief Generates a random geometric graph: vertices are uniform points in the unit square and
+     *        every pair closer than radius is an edge. Points are binned into cells of side >= radius,
+     *        so only neighboring cells are compared. The weight grows linearly with the distance,
+     *        from minWeight (touching points) to maxWeight (distance == radius).
+     *        Points and the neighbor search run in parallel blocks of vertices; only the binning is sequential.
+     *
+     * @param vertices Number of vertices.
+     * @param radius Connection radius.
+     * @param minWeight Weight of a zero-length edge.
+     * @param maxWeight Weight of an edge of length radius.
+     * @param seed Random seed.
+     * @param numThreads Number of threads (the graph is the same for any value).
+     * @return Graph The generated graph.
+     */
+    Graph Generators::randomGeometric(int vertices, double radius, int minWeight, int maxWeight, unsigned long long seed,
+                                      int numThreads) {
+        if (vertices < 0 || radius < 0.0) {
+            throw std::invalid_argument("Invalid random geometric parameters.");
+        }
+        checkWeights(minWeight, maxWeight);
+        Graph g(vertices);
+        int numBlocks = (int)(((long long)vertices + BLOCK - 1) / BLOCK);
+        double* xs = new double[vertices];
+        double* ys = new double[vertices];
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int k = begin; k < end; k++) {
+                SplitMix rng = blockStream(seed, k);
+                int last = (long long)(k + 1) * BLOCK < vertices ? (k + 1) * BLOCK : vertices;
+                for (int i = k * BLOCK; i < last; i++) {
+                    xs[i] = rng.uniform();
+                    ys[i] = rng.uniform();
+                }
+            }
+        }, 1);
+
+        // k x k cells, each at least radius wide, and no more cells than about 4 per point
+        int k = 1;
+        if (radius > 0.0) {
+            double perSide = std::floor(1.0 / radius);
+            double limit = std::floor(std::sqrt(4.0 * vertices)) + 1.0;
+            k = (int)(perSide < limit ? perSide : limit);
+            if (k < 1) k = 1;
+        }
+        int cells = k * k;
+        int* cellStart = new int[cells + 1];
+        int* cellOf = new int[vertices];
+        int* sorted = new int[vertices];
+        for (int i = 0; i <= cells; i++) cellStart[i] = 0;
+        for (int i = 0; i < vertices; i++) {
+            int cx = (int)(xs[i] * k), cy = (int)(ys[i] * k);
+            cellOf[i] = cy * k + cx;
+            cellStart[cellOf[i] + 1]++;
+        }
+        for (int i = 0; i < cells; i++) cellStart[i + 1] += cellStart[i];
+        int* cursor = new int[cells];
+        for (int i = 0; i < cells; i++) cursor[i] = cellStart[i];
+        for (int i = 0; i < vertices; i++) sorted[cursor[cellOf[i]]++] = i;
+
+        double r2 = radius * radius;
+        EdgeBlock* blocks = new EdgeBlock[numBlocks];
+        parallelFor(numBlocks, numThreads, [&](int begin, int end, int) {
+            for (int b = begin; b < end; b++) {
+                int last = (long long)(b + 1) * BLOCK < vertices ? (b + 1) * BLOCK : vertices;
+                for (int u = b * BLOCK; u < last; u++) {
+                    int cx = cellOf[u] % k, cy = cellOf[u] / k;
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            int nx = cx + dx, ny = cy + dy;
+                            if (nx < 0 || ny < 0 || nx >= k || ny >= k) continue;
+                            int cell = ny * k + nx;
+                            for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+                                int v = sorted[i];
+                                if (v <= u) continue;
+                                double ddx = xs[u] - xs[v], ddy = ys[u] - ys[v];
+                                double d2 = ddx * ddx + ddy * ddy;
+                                if (d2 <= r2 && radius > 0.0) {
+                                    double ratio = std::sqrt(d2) / radius;
+                                    blocks[b].add(u, v, minWeight + (int)std::floor(ratio * (maxWeight - minWeight) + 0.5));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }, 1);
+        insertEdges(g, blocks, numBlocks, numThreads);
+        delete[] blocks;
+
+        delete[] xs;
+        delete[] ys;
+        delete[] cellStart;
+        delete[] cellOf;
+        delete[] sorted;
+        delete[] cursor;
+        return g;
+    }
+
+}
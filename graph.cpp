@@ -3,6 +3,25 @@
 #include "graph.hpp"
 using namespace graph;
 
+#ifdef GRAPH_STATS
+#define STAT_ADD(counter, amount) ((counter) += (amount))
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#endif
+
+namespace {
+
+    // smallest power of two >= requested (at least 1), so ring indices wrap with a mask
+    int roundUpCapacity(int requested) {
+        int capacity = 1;
+        while (capacity < requested && capacity < (1 << 30)) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+}
+
 namespace graph{
     
 // ============================
@@ -11,8 +30,8 @@ namespace graph{
 
     Stack::Stack(int capacity) 
     {
-        this->capacity = capacity;
-        this->data = new int[capacity];
+        this->capacity = roundUpCapacity(capacity);
+        this->data = new int[this->capacity];
         this->top = -1;
         this->size = 0;
     }
@@ -21,17 +40,33 @@ namespace graph{
         delete[] data;
     }
 
+    /**
+     * @brief Doubles the capacity of the stack, keeping its contents.
+     */
+    void Stack::grow() {
+        if (this->capacity >= (1 << 30)) {
+            throw std::overflow_error("Stack is full");
+        }
+        int* bigger = new int[this->capacity * 2];
+        for (int i = 0; i < this->size; i++) {
+            bigger[i] = this->data[i];
+        }
+        delete[] this->data;
+        this->data = bigger;
+        this->capacity *= 2;
+    }
+
     /**
      * @brief Pushes a vertex onto the top of the stack.
      * 
-     * This function inserts the given vertex at the top of the stack,
-     * if the stack is not already full.
+     * This function inserts the given vertex at the top of the stack.
+     * A full stack doubles its capacity first (amortized O(1) per push).
      * 
      * @param vertex The vertex to be pushed onto the stack.
      */
     void Stack::push(int vertex) {
         if (this->top >= this->capacity - 1) {
-            throw std::overflow_error("Stack is full");
+            grow();
         }
         this->data[++top] = vertex;
         size++;
@@ -85,6 +120,15 @@ namespace graph{
             throw std::underflow_error("Stack is empty"); 
         }
     }
+
+    /**
+     * @brief Returns the number of elements currently in the stack.
+     * 
+     * @return int The stack size.
+     */
+    int Stack::getSize() {
+        return this->size;
+    }
     
     
      
@@ -95,8 +139,8 @@ namespace graph{
     
     Queue::Queue(int capacity) 
     {
-        this->capacity = capacity;
-        this->data = new int[capacity];
+        this->capacity = roundUpCapacity(capacity);
+        this->data = new int[this->capacity];
         this->front = 0;
         this->rear = 0;
         this->size = 0;
@@ -105,25 +149,42 @@ namespace graph{
         delete[] data;
     }
 
+    /**
+     * @brief Doubles the capacity of the queue, unrolling the ring so the front lands at index 0.
+     */
+    void Queue::grow() {
+        if (this->capacity >= (1 << 30)) {
+            throw std::overflow_error("Queue is full");
+        }
+        int mask = this->capacity - 1;
+        int* bigger = new int[this->capacity * 2];
+        for (int i = 0; i < this->size; i++) {
+            bigger[i] = this->data[(this->front + i) & mask];
+        }
+        delete[] this->data;
+        this->data = bigger;
+        this->front = 0;
+        this->rear = this->size;
+        this->capacity *= 2;
+    }
+
     /**
      * @brief Adds a vertex to the end of the queue.
      * 
-     * This function inserts the given vertex into the queue,
-     * if the queue is not already full.
+     * This function inserts the given vertex into the queue.
+     * A full queue doubles its capacity first (amortized O(1) per enqueue).
      * 
      * @param vertex The vertex to be enqueued.
-     * @return true If the vertex was successfully enqueued.
-     * @return false If the queue is full and the vertex could not be enqueued.
+     * @return true Always; kept for compatibility with the fixed-capacity interface.
      */
     bool Queue::enqueue(int vertex) {
-        if (size < capacity) {
-            this->data[rear] = vertex;
-            this->rear = (this->rear + 1) % this->capacity;
-            this->size++;
-            return true;
-        } else {
-            throw std::overflow_error("Queue is full");
+        if (this->size == this->capacity) {
+            grow();
         }
+        this->data[rear] = vertex;
+        this->rear = (this->rear + 1) & (this->capacity - 1);
+        this->size++;
+        return true;
     }
 
     /**
@@ -139,7 +200,7 @@ namespace graph{
             throw std::underflow_error("Queue is empty");        
         }
         int firstVer = this->data[front];
-        this->front = (this->front + 1) % this->capacity;
+        this->front = (this->front + 1) & (this->capacity - 1);
         this->size--;
         return firstVer;
     }
@@ -158,6 +219,16 @@ namespace graph{
         return this->size == 0;
     }
 
+    /**
+     * @brief Returns the number of elements currently in the queue.
+     * 
+     * @return int The queue size.
+     */
+    int Queue::getSize()
+    {
+        return this->size;
+    }
+
 // ============================
 //     PRIORITY QUEUE SECTION
 // ============================
@@ -174,15 +245,17 @@ namespace graph{
 
     /**
      * @brief Inserts a vertex into the priority queue with a given priority.
-     *        If the queue is full, the function prints a warning and returns.
+     *        The capacity is fixed, so a full queue is an error: dropping the entry would silently
+     *        lose a vertex (lazy-insert users size the queue by arc count).
      * 
      * @param vertex The vertex to insert.
      * @param priority The priority value (lower means higher priority).
+     * 
+     * @throws std::overflow_error If the queue is full.
      */
     void PriorityQueue::insert(int vertex, int priority) {
         if (size == capacity) {
-            std::cout << "Priority Queue is full." << std::endl;
-            return;
+            throw std::overflow_error("Priority Queue is full");
         }
         heap[size] = {vertex, priority};
         heapifyUp(size);
@@ -281,36 +354,39 @@ namespace graph{
 //         UNION SET SECTION
 // ============================  
 
-    UnionFind::UnionFind(int size) : size(size) {
+    UnionFind::UnionFind(int size) : size(size), findSteps(0) {
         parent = new int[size];
-        rank = new int[size];
 
         for (int i = 0; i < size; ++i) {
-            parent[i] = i;
-            rank[i] = 0;
+            parent[i] = -1;
         }
     }
 
     UnionFind::~UnionFind() {
         delete[] parent;
-        delete[] rank;
     }
     /**
      * @brief Finds the representative (root) of the set that contains the given node.
-     *        Implements path compression to flatten the structure for efficiency.
+     *        Iterative path halving: every visited node is re-linked to its grandparent,
+     *        so paths shrink without recursion or extra memory.
      * 
      * @param node The node whose set representative is to be found.
      * @return int The representative of the set containing the node.
      */
     int UnionFind::find(int node) {
-        if (parent[node] != node) {
-            parent[node] = find(parent[node]);
+        while (parent[node] >= 0) {
+            int up = parent[node];
+            if (parent[up] >= 0) {
+                parent[node] = parent[up];
+            }
+            STAT_ADD(findSteps, 1);
+            node = parent[node];
         }
-        return parent[node];
+        return node;
     }
     /**
      * @brief Unites the sets that contain the given two nodes.
-     *        Uses union by rank to keep the tree shallow and efficient.
+     *        Uses union by size: the smaller tree is hung under the root of the larger one.
      * 
      * @param u The first node.
      * @param v The second node.
@@ -322,26 +398,173 @@ namespace graph{
         if (uRoot == vRoot)
             return;
 
-        if (rank[uRoot] < rank[vRoot]) {
-            parent[uRoot] = vRoot;
-        } else if (rank[uRoot] > rank[vRoot]) {
-            parent[vRoot] = uRoot;
-        } else {
-            parent[vRoot] = uRoot;
-            rank[uRoot]++;
+        if (parent[uRoot] > parent[vRoot]) { // sizes are stored negated, so uRoot is the smaller set
+            int temp = uRoot;
+            uRoot = vRoot;
+            vRoot = temp;
         }
+        parent[uRoot] += parent[vRoot];
+        parent[vRoot] = uRoot;
+    }
+    /**
+     * @brief Checks whether two nodes belong to the same set.
+     * 
+     * @param u The first node.
+     * @param v The second node.
+     * @return true If u and v have the same representative.
+     */
+    bool UnionFind::connected(int u, int v) {
+        return find(u) == find(v);
+    }
+    /**
+     * @brief Returns the number of elements in the set that contains the given node.
+     * 
+     * @param node The node.
+     * @return int The size of its set.
+     */
+    int UnionFind::componentSize(int node) {
+        return -parent[find(node)];
     }
     /**
-     * @brief Resets the Union-Find structure, making each element its own parent.
-     *        Also resets all ranks to zero.
+     * @brief Resets the Union-Find structure, making each element its own singleton set.
+     *        Also resets the find step counter to zero.
      */
     void UnionFind::reset() {
+        findSteps = 0;
+        for (int i = 0; i < size; ++i) {
+            parent[i] = -1;
+        }
+    }
+
+    /**
+     * @brief Returns how many parent links find has followed so far.
+     *        Always 0 unless the library is built with -DGRAPH_STATS.
+     * 
+     * @return long long The number of links followed.
+     */
+    long long UnionFind::getFindSteps() {
+        return findSteps;
+    }
+
+
+// ============================
+//   CONCURRENT UNION SET SECTION
+// ============================  
+
+    ConcurrentUnionFind::ConcurrentUnionFind(int size, unsigned long long seed) : size(size), seed(seed) {
+        parent = new std::atomic<int>[size];
+        for (int i = 0; i < size; ++i) {
+            parent[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentUnionFind::~ConcurrentUnionFind() {
+        delete[] parent;
+    }
+
+    /**
+     * @brief Returns the fixed random linking priority of a node (a SplitMix64 hash of node and seed).
+     *        Roots are only ever linked below roots of higher priority, so no cycle can form
+     *        and trees stay O(log n) deep in expectation regardless of the union order.
+     */
+    unsigned long long ConcurrentUnionFind::priority(int node) {
+        unsigned long long z = (unsigned long long)node + seed * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Finds the current root of the set containing node.
+     *        Path halving with compare-and-swap: a failed CAS only means another thread already
+     *        moved the link higher, so it is simply ignored. Lock-free.
+     * 
+     * @param node The node.
+     * @return int The root at the moment it was reached.
+     */
+    int ConcurrentUnionFind::find(int node) {
+        while (true) {
+            int up = parent[node].load(std::memory_order_acquire);
+            if (up == node) {
+                return node;
+            }
+            int grand = parent[up].load(std::memory_order_acquire);
+            if (up != grand) {
+                parent[node].compare_exchange_weak(up, grand, std::memory_order_release, std::memory_order_relaxed);
+            }
+            node = grand;
+        }
+    }
+
+    /**
+     * @brief Merges the sets containing u and v.
+     *        The lower-priority root is linked under the other with a CAS that succeeds only if it
+     *        is still a root; on failure the roots are looked up again. Lock-free.
+     * 
+     * @param u The first node.
+     * @param v The second node.
+     * @return true If this call merged two different sets.
+     * @return false If u and v were already in the same set.
+     */
+    bool ConcurrentUnionFind::unite(int u, int v) {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) {
+                return false;
+            }
+            unsigned long long pu = priority(u), pv = priority(v);
+            if (pu > pv || (pu == pv && u > v)) { // make u the lower-priority root
+                int temp = u;
+                u = v;
+                v = temp;
+            }
+            int expected = u;
+            if (parent[u].compare_exchange_strong(expected, v, std::memory_order_acq_rel)) {
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Checks whether u and v are in the same set.
+     *        The answer "different" is only returned after confirming u's root is still a root,
+     *        so it is correct at that instant even while other threads keep uniting.
+     * 
+     * @param u The first node.
+     * @param v The second node.
+     * @return true If u and v are connected.
+     */
+    bool ConcurrentUnionFind::connected(int u, int v) {
+        while (true) {
+            u = find(u);
+            v = find(v);
+            if (u == v) {
+                return true;
+            }
+            if (parent[u].load(std::memory_order_acquire) == u) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Makes every element its own singleton set again.
+     *        Must not run concurrently with other operations.
+     */
+    void ConcurrentUnionFind::reset() {
         for (int i = 0; i < size; ++i) {
-            parent[i] = i;
-            rank[i] = 0;
+            parent[i].store(i, std::memory_order_relaxed);
         }
     }
 
+    /**
+     * @brief Returns the number of elements.
+     */
+    int ConcurrentUnionFind::getSize() {
+        return size;
+    }
+
 
     
 // ============================
@@ -518,4 +741,462 @@ namespace graph{
     }
 
 
+// ============================
+//         CSR SECTION
+// ============================  
+
+    /**
+     * @brief Builds a compressed sparse row snapshot of the graph.
+     *        Arcs are bucketed twice with counting sort (first by target, then by source),
+     *        so every row comes out sorted by neighbor id in O(V + E) time without comparisons.
+     * 
+     * @param g The source graph.
+     * @param transpose If true, row v lists the sources of the arcs entering v.
+     */
+    CSRGraph::CSRGraph(Graph& g, bool transpose)
+    {
+        this->numVertices = g.getNumVertices();
+        this->numArcs = 0;
+        Node** adjList = g.getAdjList();
+        int V = this->numVertices;
+
+        // first pass: bucket every arc u -> v by its target v, visiting sources in increasing order
+        long long* byTargetOff = new long long[V + 1];
+        for (int i = 0; i <= V; i++) {
+            byTargetOff[i] = 0;
+        }
+        for (int u = 0; u < V; u++) {
+            for (Node* n = adjList[u]; n != nullptr; n = n->next) {
+                byTargetOff[n->vertex + 1]++;
+                this->numArcs++;
+            }
+        }
+        for (int i = 0; i < V; i++) {
+            byTargetOff[i + 1] += byTargetOff[i];
+        }
+
+        int* bySource = new int[numArcs];
+        int* byWeight = new int[numArcs];
+        long long* cursor = new long long[V + 1];
+        for (int i = 0; i <= V; i++) {
+            cursor[i] = byTargetOff[i];
+        }
+        for (int u = 0; u < V; u++) {
+            for (Node* n = adjList[u]; n != nullptr; n = n->next) {
+                long long pos = cursor[n->vertex]++;
+                bySource[pos] = u;
+                byWeight[pos] = n->weight;
+            }
+        }
+
+        if (transpose) { // rows by target, already sorted by source
+            this->offsets = byTargetOff;
+            this->targets = bySource;
+            this->weights = byWeight;
+            delete[] cursor;
+            return;
+        }
+
+        // second pass: scatter back into rows by source, visiting targets in increasing order
+        this->offsets = new long long[V + 1];
+        this->targets = new int[numArcs];
+        this->weights = new int[numArcs];
+        for (int i = 0; i <= V; i++) {
+            offsets[i] = 0;
+        }
+        for (long long i = 0; i < numArcs; i++) {
+            offsets[bySource[i] + 1]++;
+        }
+        for (int i = 0; i < V; i++) {
+            offsets[i + 1] += offsets[i];
+        }
+        for (int i = 0; i <= V; i++) {
+            cursor[i] = offsets[i];
+        }
+        for (int v = 0; v < V; v++) {
+            for (long long i = byTargetOff[v]; i < byTargetOff[v + 1]; i++) {
+                long long pos = cursor[bySource[i]]++;
+                targets[pos] = v;
+                weights[pos] = byWeight[i];
+            }
+        }
+
+        delete[] byTargetOff;
+        delete[] bySource;
+        delete[] byWeight;
+        delete[] cursor;
+    }
+
+    CSRGraph::~CSRGraph() {
+        delete[] offsets;
+        delete[] targets;
+        delete[] weights;
+    }
+
+    /**
+     * @brief Returns the number of vertices in the snapshot.
+     * 
+     * @return int Number of vertices.
+     */
+    int CSRGraph::getNumVertices() {
+        return this->numVertices;
+    }
+
+    /**
+     * @brief Returns the number of stored arcs (an undirected edge is stored twice).
+     * 
+     * @return long long Number of arcs.
+     */
+    long long CSRGraph::getNumArcs() {
+        return this->numArcs;
+    }
+
+    /**
+     * @brief Returns the row offsets array (numVertices + 1 entries).
+     */
+    long long* CSRGraph::getOffsets() {
+        return offsets;
+    }
+
+    /**
+     * @brief Returns the neighbor array, sorted ascending inside each row.
+     */
+    int* CSRGraph::getTargets() {
+        return targets;
+    }
+
+    /**
+     * @brief Returns the arc weights, aligned with the neighbor array.
+     */
+    int* CSRGraph::getWeights() {
+        return weights;
+    }
+
+    /**
+     * @brief Returns the number of arcs in the row of v.
+     *        If the vertex is invalid, throws an out_of_range exception.
+     * 
+     * @param v The vertex.
+     * @return int The row length of v.
+     */
+    int CSRGraph::degree(int v) {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("Vertex index out of range.");
+        }
+        return (int)(offsets[v + 1] - offsets[v]);
+    }
+
+// ============================
+//     COMPRESSED SECTION
+// ============================  
+
+    /**
+     * @brief Writes value as an LEB128 varint (7 bits per byte, high bit = more bytes follow).
+     * 
+     * @return long long The position right after the written bytes.
+     */
+    static long long writeVarint(unsigned char* out, long long pos, unsigned int value) {
+        while (value >= 0x80) {
+            out[pos++] = (unsigned char)(value | 0x80);
+            value >>= 7;
+        }
+        out[pos++] = (unsigned char)value;
+        return pos;
+    }
+
+    /**
+     * @brief Reads an LEB128 varint and advances pos past it.
+     */
+    static inline unsigned int readVarint(const unsigned char* in, long long& pos) {
+        unsigned int value = in[pos] & 0x7F;
+        int shift = 7;
+        while (in[pos++] & 0x80) {
+            value |= (unsigned int)(in[pos] & 0x7F) << shift;
+            shift += 7;
+        }
+        return value;
+    }
+
+    /**
+     * @brief Encodes one row: its degree, then each neighbor gap followed by the zigzag weight
+     *        (weights == nullptr stores none). With out == nullptr only the size is computed.
+     * 
+     * @param targets The neighbors, ascending.
+     * @return long long The position right after the row.
+     */
+    static long long encodeRow(unsigned char* out, long long pos, int deg, const int* targets, const int* weights) {
+        unsigned char scratch[5];
+        pos = out != nullptr ? writeVarint(out, pos, (unsigned int)deg) : pos + writeVarint(scratch, 0, (unsigned int)deg);
+        int prev = 0;
+        for (int i = 0; i < deg; i++) {
+            unsigned int gap = (unsigned int)(targets[i] - prev);
+            prev = targets[i];
+            pos = out != nullptr ? writeVarint(out, pos, gap) : pos + writeVarint(scratch, 0, gap);
+            if (weights != nullptr) {
+                unsigned int z = ((unsigned int)weights[i] << 1) ^ (unsigned int)(weights[i] >> 31);
+                pos = out != nullptr ? writeVarint(out, pos, z) : pos + writeVarint(scratch, 0, z);
+            }
+        }
+        return pos;
+    }
+
+    /**
+     * @brief Heap sort of (neighbor << 32 | weight) keys, so a row sorts by neighbor without extra memory.
+     */
+    static void sortPacked(long long* items, int count) {
+        auto siftDown = [&](int root, int end) {
+            while (2 * root + 1 < end) {
+                int child = 2 * root + 1;
+                if (child + 1 < end && items[child] < items[child + 1]) child++;
+                if (items[root] >= items[child]) return;
+                long long temp = items[root];
+                items[root] = items[child];
+                items[child] = temp;
+                root = child;
+            }
+        };
+        for (int i = count / 2 - 1; i >= 0; i--) siftDown(i, count);
+        for (int end = count - 1; end > 0; end--) {
+            long long temp = items[0];
+            items[0] = items[end];
+            items[end] = temp;
+            siftDown(0, end);
+        }
+    }
+
+    /**
+     * @brief Builds the compressed rows from a sorted CSR snapshot.
+     *        Each row holds its degree, then the first neighbor and the gaps between consecutive
+     *        neighbors, each followed by the zigzag-encoded weight unless every weight is 1.
+     *        Small gaps take one byte, so a typical arc costs one to three bytes.
+     * 
+     * @param g The source graph.
+     */
+    CompressedGraph::CompressedGraph(Graph& g)
+    {
+        CSRGraph csr(g);
+        long long* rowOff = csr.getOffsets();
+        int* targets = csr.getTargets();
+        int* rowWeights = csr.getWeights();
+        this->numVertices = csr.getNumVertices();
+        this->numArcs = csr.getNumArcs();
+        this->maxDegree = 0;
+        this->weighted = false;
+        for (long long i = 0; i < numArcs; i++) {
+            if (rowWeights[i] != 1) {
+                weighted = true;
+                break;
+            }
+        }
+        int* stored = weighted ? rowWeights : nullptr;
+
+        // one pass to size the buffer, one pass to fill it
+        this->offsets = new long long[numVertices + 1];
+        long long total = 0;
+        for (int v = 0; v < numVertices; v++) {
+            offsets[v] = total;
+            int deg = (int)(rowOff[v + 1] - rowOff[v]);
+            if (deg > maxDegree) maxDegree = deg;
+            total = encodeRow(nullptr, total, deg, targets + rowOff[v], stored == nullptr ? nullptr : stored + rowOff[v]);
+        }
+        offsets[numVertices] = total;
+
+        this->bytes = new unsigned char[total];
+        for (int v = 0; v < numVertices; v++) {
+            encodeRow(bytes, offsets[v], (int)(rowOff[v + 1] - rowOff[v]), targets + rowOff[v],
+                      stored == nullptr ? nullptr : stored + rowOff[v]);
+        }
+    }
+
+    /**
+     * @brief Encodes an edge list directly, without building a Graph or a CSRGraph first, so the peak
+     *        memory is the edge list, the encoded rows, and a buffer of bufferArcs arcs (12 bytes each).
+     *        Rows are built in consecutive vertex ranges whose arcs fit in the buffer: every range scans
+     *        the edge list, sorts its rows and encodes them. A sizing pass and a filling pass each do this,
+     *        so the edge list is read 2 * ranges times (once per pass when everything fits). The edges
+     *        need not be sorted; duplicates are kept as parallel arcs.
+     * 
+     * @param numVertices Number of vertices.
+     * @param sources Edge sources.
+     * @param targets Edge targets.
+     * @param weights Edge weights, or nullptr for all 1.
+     * @param numEdges Number of edges.
+     * @param directed If false (the default), every edge is stored in both rows, like Graph::addEdge.
+     * @param bufferArcs Arcs gathered at a time (a row larger than that gets a range of its own).
+     * 
+     * @throws std::invalid_argument If numVertices or numEdges is negative.
+     * @throws std::out_of_range If an endpoint is not a valid vertex.
+     */
+    CompressedGraph::CompressedGraph(int numVertices, const int* sources, const int* targets, const int* weights,
+                                     long long numEdges, bool directed, long long bufferArcs)
+    {
+        if (numVertices < 0 || numEdges < 0) {
+            throw std::invalid_argument("Invalid edge list size.");
+        }
+        for (long long e = 0; e < numEdges; e++) {
+            if (sources[e] < 0 || sources[e] >= numVertices || targets[e] < 0 || targets[e] >= numVertices) {
+                throw std::out_of_range("Vertex index out of range.");
+            }
+        }
+        int V = numVertices;
+        this->numVertices = V;
+        this->maxDegree = 0;
+        this->weighted = false;
+        for (long long e = 0; weights != nullptr && e < numEdges; e++) {
+            if (weights[e] != 1) {
+                weighted = true;
+                break;
+            }
+        }
+
+        int* degrees = new int[V];
+        for (int v = 0; v < V; v++) degrees[v] = 0;
+        for (long long e = 0; e < numEdges; e++) {
+            degrees[sources[e]]++;
+            if (!directed) degrees[targets[e]]++;
+        }
+        this->numArcs = directed ? numEdges : 2 * numEdges;
+        for (int v = 0; v < V; v++) {
+            if (degrees[v] > maxDegree) maxDegree = degrees[v];
+        }
+        long long capacity = bufferArcs > maxDegree ? bufferArcs : maxDegree;
+        if (capacity > numArcs) capacity = numArcs;
+        long long* packed = new long long[capacity > 0 ? capacity : 1]; // neighbor << 32 | weight
+        long long* rowStart = new long long[V + 1];                     // inside packed, current range only
+        int* rowTargets = new int[maxDegree > 0 ? maxDegree : 1];
+        int* rowWeights = new int[maxDegree > 0 ? maxDegree : 1];
+
+        // gathers and sorts the rows of [first, last) into packed
+        auto gather = [&](int first, int last) {
+            rowStart[first] = 0;
+            for (int v = first; v < last; v++) rowStart[v + 1] = rowStart[v] + degrees[v];
+            for (long long e = 0; e < numEdges; e++) {
+                long long w = (unsigned int)(weights == nullptr ? 1 : weights[e]);
+                int u = sources[e], v = targets[e];
+                if (u >= first && u < last) packed[rowStart[u]++] = ((long long)v << 32) | w;
+                if (!directed && v >= first && v < last) packed[rowStart[v]++] = ((long long)u << 32) | w;
+            }
+            for (int v = last; v > first; v--) rowStart[v] = rowStart[v - 1];
+            rowStart[first] = 0;
+            for (int v = first; v < last; v++) sortPacked(packed + rowStart[v], degrees[v]);
+        };
+        // encodes row v from packed at pos (sizing only when out == nullptr)
+        auto encode = [&](unsigned char* out, long long pos, int v) {
+            for (int i = 0; i < degrees[v]; i++) {
+                long long item = packed[rowStart[v] + i];
+                rowTargets[i] = (int)(item >> 32);
+                rowWeights[i] = (int)(unsigned int)item;
+            }
+            return encodeRow(out, pos, degrees[v], rowTargets, weighted ? rowWeights : nullptr);
+        };
+
+        this->offsets = new long long[V + 1];
+        long long total = 0;
+        int lastGathered = -1; // first vertex of the range still held in packed
+        for (int pass = 0; pass < 2; pass++) {
+            if (pass == 1) this->bytes = new unsigned char[total];
+            int first = 0;
+            while (first < V) {
+                int last = first;
+                long long arcs = 0;
+                while (last < V && (last == first || arcs + degrees[last] <= capacity)) arcs += degrees[last++];
+                if (first != lastGathered || pass == 0) gather(first, last);
+                lastGathered = first;
+                for (int v = first; v < last; v++) {
+                    if (pass == 0) {
+                        offsets[v] = total;
+                        total = encode(nullptr, total, v);
+                    }
+                    else {
+                        encode(bytes, offsets[v], v);
+                    }
+                }
+                first = last;
+            }
+            if (pass == 0) offsets[V] = total;
+        }
+        delete[] degrees;
+        delete[] packed;
+        delete[] rowStart;
+        delete[] rowTargets;
+        delete[] rowWeights;
+    }
+
+    CompressedGraph::~CompressedGraph() {
+        delete[] offsets;
+        delete[] bytes;
+    }
+
+    /**
+     * @brief Returns the number of vertices.
+     */
+    int CompressedGraph::getNumVertices() {
+        return this->numVertices;
+    }
+
+    /**
+     * @brief Returns the number of stored arcs (an undirected edge is stored twice).
+     */
+    long long CompressedGraph::getNumArcs() {
+        return this->numArcs;
+    }
+
+    /**
+     * @brief Returns the size of the encoded rows in bytes (the offsets array not included).
+     */
+    long long CompressedGraph::getNumBytes() {
+        return offsets[numVertices];
+    }
+
+    /**
+     * @brief Returns the largest row length, i.e. the buffer size decodeNeighbors needs.
+     */
+    int CompressedGraph::getMaxDegree() {
+        return this->maxDegree;
+    }
+
+    /**
+     * @brief Returns the number of neighbors of v without decoding the row.
+     *        If the vertex is invalid, throws an out_of_range exception.
+     * 
+     * @param v The vertex.
+     * @return int The row length of v.
+     */
+    int CompressedGraph::degree(int v) {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("Vertex index out of range.");
+        }
+        long long pos = offsets[v];
+        return (int)readVarint(bytes, pos);
+    }
+
+    /**
+     * @brief Decodes the row of v into the caller buffers.
+     *        If the vertex is invalid, throws an out_of_range exception.
+     * 
+     * @param v The vertex.
+     * @param vertices Receives the neighbors in ascending order.
+     * @param weights Receives the weights (may be nullptr).
+     * @return int The number of neighbors.
+     */
+    int CompressedGraph::decodeNeighbors(int v, int* vertices, int* weights) {
+        if (v < 0 || v >= numVertices) {
+            throw std::out_of_range("Vertex index out of range.");
+        }
+        long long pos = offsets[v];
+        int deg = (int)readVarint(bytes, pos);
+        int prev = 0;
+        for (int i = 0; i < deg; i++) {
+            prev += (int)readVarint(bytes, pos);
+            vertices[i] = prev;
+            int w = 1;
+            if (weighted) {
+                unsigned int z = readVarint(bytes, pos);
+                w = (int)(z >> 1) ^ -(int)(z & 1);
+            }
+            if (weights != nullptr) weights[i] = w;
+        }
+        return deg;
+    }
+
 } // namespace graph
\ No newline at end of file
@@ -4,6 +4,7 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include <atomic>
 #include <iostream>
 #include <stdexcept>
 
@@ -21,21 +22,23 @@ namespace graph {
 
     class Queue { // it will help us implement the bfs / dfs
         int* data; // an array of the indexes ?
-        int front,rear,size,capacity; // first, last , current size , capacity
+        int front,rear,size,capacity; // first, last , current size , capacity (a power of two)
+        void grow();
         public:
             bool enqueue(int vertex); // add a vertex to the stack.
             int dequeue(); // remove the first vertex of the stack.
             bool isEmpty(); // check if the stack is empty
-            Queue(int capacity);                 // constructor (does the size is necesiry?)
+            int getSize(); // number of queued vertices
+            Queue(int capacity = 16);            // initial capacity, rounded up to a power of two; grows on demand
             ~Queue();                                //  desctructor
 
     };
 
     class UnionFind {
         private:
-            int* parent;
-            int* rank;
+            int* parent; // parent of each node, or -(set size) for a root
             int size;
+            long long findSteps; // parent links followed by find (counted only with GRAPH_STATS)
         
         public:
             UnionFind(int size);
@@ -43,7 +46,28 @@ namespace graph {
         
             int find(int node);
             void unite(int u, int v);
+            bool connected(int u, int v);
+            int componentSize(int node);
             void reset();
+            long long getFindSteps();
+    };
+
+    class ConcurrentUnionFind { // lock-free union-find: find, unite and connected may run from many threads at once
+        private:
+            std::atomic<int>* parent; // parent of each node (a root points to itself)
+            int size;
+            unsigned long long seed;  // picks the random linking priorities
+            unsigned long long priority(int node);
+
+        public:
+            ConcurrentUnionFind(int size, unsigned long long seed = 1);
+            ~ConcurrentUnionFind();
+
+            int find(int node);
+            bool unite(int u, int v);
+            bool connected(int u, int v);
+            void reset(); // not thread-safe: call only while no other thread uses the structure
+            int getSize();
     };
         
         
@@ -57,13 +81,15 @@ namespace graph {
         int top;
         int capacity;
         int size;
+        void grow();
 
         public:
         void push(int vertex);
         int pop();
         int peek();
         bool isEmpty();
-        Stack(int capacity);                 // constructor (does the size is necesiry?)
+        int getSize();
+        Stack(int capacity = 16);            // initial capacity; grows on demand
         ~Stack();                                //  desctructor
 
     };
@@ -144,15 +170,170 @@ namespace graph {
             void addDirectedEdge(int src, int dst, int weight = 1);
         };
 
+    class CSRGraph { // read-only compressed sparse row snapshot of a Graph
+        private:
+            int numVertices;
+            long long numArcs;   // number of directed arcs (an undirected edge counts twice)
+            long long* offsets;  // neighbors of v are targets[offsets[v]] .. targets[offsets[v+1]-1]
+            int* targets;        // neighbor vertices, sorted ascending inside each row
+            int* weights;        // weight of each arc, aligned with targets
+
+        public:
+            /**
+             * @brief Builds a CSR snapshot of the adjacency lists of g.
+             * 
+             * @param g The source graph.
+             * @param transpose If true, row v holds the vertices u with an arc u -> v.
+             */
+            CSRGraph(Graph& g, bool transpose = false);
+            ~CSRGraph();
+
+            int getNumVertices();
+            long long getNumArcs();
+            long long* getOffsets();
+            int* getTargets();
+            int* getWeights();
+            int degree(int v);
+    };
+
+    class CompressedGraph { // read-only adjacency with gap + varint encoded neighbor lists
+        private:
+            int numVertices;
+            long long numArcs;
+            int maxDegree;
+            bool weighted;          // false when every weight is 1, then weights are not stored
+            long long* offsets;     // byte offset of the row of each vertex (numVertices + 1 entries)
+            unsigned char* bytes;   // per row: degree, then the sorted neighbor gaps (and weights)
+
+        public:
+            /**
+             * @brief Encodes the adjacency lists of g (sorted, gap encoded, LEB128 varints).
+             * 
+             * @param g The source graph.
+             */
+            CompressedGraph(Graph& g);
+
+            /**
+             * @brief Encodes an edge list directly, a vertex range at a time, without a Graph or CSRGraph copy.
+             * 
+             * @param numVertices Number of vertices.
+             * @param sources Edge sources.
+             * @param targets Edge targets.
+             * @param weights Edge weights, or nullptr for all 1.
+             * @param numEdges Number of edges.
+             * @param directed If false, every edge is stored in both rows.
+             * @param bufferArcs Arcs gathered at a time, the memory bound of the construction.
+             */
+            CompressedGraph(int numVertices, const int* sources, const int* targets, const int* weights,
+                            long long numEdges, bool directed = false, long long bufferArcs = 1LL << 22);
+            ~CompressedGraph();
+
+            int getNumVertices();
+            long long getNumArcs();
+            long long getNumBytes();
+            int getMaxDegree();
+            int degree(int v);
+
+            /**
+             * @brief Decodes the neighbors of v into caller buffers of at least getMaxDegree() entries.
+             * 
+             * @param v The vertex.
+             * @param vertices Receives the neighbors, ascending.
+             * @param weights Receives the matching weights (may be nullptr).
+             * @return int The number of neighbors written.
+             */
+            int decodeNeighbors(int v, int* vertices, int* weights);
+    };
+
+    class Generators { // synthetic graph families for tests and benchmarks (all undirected, reproducible by seed)
+    public:
+
+    static Graph erdosRenyi(int vertices, double p, int minWeight = 1, int maxWeight = 1, unsigned long long seed = 1,
+                            int numThreads = 1);
+    static Graph rmat(int scale, int edgeFactor, double a = 0.57, double b = 0.19, double c = 0.19,
+                      int minWeight = 1, int maxWeight = 1, unsigned long long seed = 1, int numThreads = 1);
+    static Graph barabasiAlbert(int vertices, int edgesPerVertex, int minWeight = 1, int maxWeight = 1, unsigned long long seed = 1,
+                                int numThreads = 1);
+    static Graph grid(int rows, int cols, int minWeight = 1, int maxWeight = 1, unsigned long long seed = 1,
+                      int numThreads = 1);
+    static Graph randomGeometric(int vertices, double radius, int minWeight = 1, int maxWeight = 1, unsigned long long seed = 1,
+                                 int numThreads = 1);
+
+    };
+
+    enum ReorderStrategy { // vertex relabeling strategies used by Algorithms::reorder
+        REORDER_RCM,    // Reverse Cuthill-McKee (small bandwidth)
+        REORDER_DEGREE, // highest degree first
+        REORDER_BFS,    // breadth-first discovery order
+        REORDER_GORDER  // greedy window ordering that keeps vertices with shared neighbors together
+    };
+
+    enum MaxFlowAlgorithm { // max-flow solvers used by Algorithms::maxFlow
+        MAXFLOW_DINIC,        // level graph + blocking flows
+        MAXFLOW_PUSH_RELABEL  // highest-label push-relabel with global relabeling
+    };
+
+    enum ColoringStrategy { // vertex orderings used by Algorithms::greedyColoring
+        COLORING_LARGEST_FIRST,  // descending degree
+        COLORING_SMALLEST_LAST,  // reverse minimum-degree peeling (at most degeneracy + 1 colors)
+        COLORING_JONES_PLASSMANN // parallel rounds of locally highest-priority vertices
+    };
+
+    struct AlgorithmStats { // hot-path counters of the last Algorithms call (all zero unless built with -DGRAPH_STATS)
+        long long verticesSettled;  // vertices dequeued / popped / extracted for processing
+        long long edgesScanned;     // adjacency entries examined
+        long long relaxSuccesses;   // edges that improved a tentative distance or key
+        long long heapInserts;
+        long long heapExtracts;
+        long long heapDecreaseKeys;
+        long long queuePeak;        // largest BFS queue / DFS stack size
+        long long findSteps;        // parent links followed by UnionFind::find
+    };
+
     class Algorithms{
     public:
 
+    // counters of the last call made on the calling thread; each thread keeps its own, so concurrent calls don't mix
+    static AlgorithmStats getStats();
+
     static Graph bfs(Graph& g , int start);
+    static Graph bfs(CompressedGraph& g, int start);
     static Graph dfs(Graph& g, int start);
+    static Graph dfs(CompressedGraph& g, int start);
     static Graph dijkstra(Graph& g, int start);
     static Graph prim(Graph& g);
     static Graph kruskal(Graph& g);
     static void relax(int u, int v, int weight, int* distances, int* parent, PriorityQueue& pq);       
+    static long long countTriangles(Graph& g, long long* perVertex = nullptr, int numThreads = 1);
+    static Graph reorder(Graph& g, ReorderStrategy strategy, int* perm);
+    static int connectedComponents(Graph& g, int* labels, int numThreads = 1);
+    static Graph stronglyConnectedComponents(Graph& g, int* componentIds, int numThreads = 1);
+    static void multiSourceBfs(Graph& g, const int* sources, int numSources, int* distances, int numThreads = 1);
+    static void floydWarshall(Graph& g, int* distances, int numThreads = 1);
+    static void allPairsDijkstra(Graph& g, int* distances, int numThreads = 1);
+    static bool bellmanFord(Graph& g, int start, int* distances, int* parent = nullptr);
+    static void johnson(Graph& g, int* distances, int numThreads = 1);
+    static int pagerank(Graph& g, double* ranks, double damping = 0.85, double tolerance = 1e-9,
+                        int maxIterations = 100, int numThreads = 1);
+    static int coreNumbers(Graph& g, int* cores, int numThreads = 1);
+    static double betweenness(Graph& g, double* centrality, bool weighted = false, int samples = 0,
+                              int numThreads = 1, unsigned long long seed = 1);
+    static long long maxFlow(Graph& g, int source, int sink, MaxFlowAlgorithm algorithm = MAXFLOW_DINIC,
+                             bool* sourceSide = nullptr);
+    static bool isBipartite(Graph& g, int* side = nullptr);
+    static int maxBipartiteMatching(Graph& g, int* mate);
+    static bool topologicalSort(Graph& g, int* order, int numThreads = 1);
+    static void dagShortestPaths(Graph& g, int start, int* distances, bool longest = false, int* parent = nullptr);
+    static int greedyColoring(Graph& g, int* colors, ColoringStrategy strategy = COLORING_SMALLEST_LAST,
+                              int numThreads = 1, unsigned long long seed = 1);
+    static double modularity(Graph& g, const int* communities);
+    static int louvain(Graph& g, int* communities, double* passModularity = nullptr, int maxPasses = 32,
+                       int numThreads = 1);
+    static int labelPropagation(Graph& g, int* labels, int maxIterations = 20, int numThreads = 1,
+                                unsigned long long seed = 1);
+    static int articulationPoints(Graph& g, bool* articulation);
+    static int bridges(Graph& g, int* endpoints);
+    static int biconnectedComponents(Graph& g, int* arcComponents);
 
     };
 
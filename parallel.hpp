@@ -0,0 +1,51 @@
+// dor.cohen15@msmail.ariel.ac.il
+
+// internal threading helper shared by algorithms.cpp and generators.cpp (not part of the public API)
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+    /**
+     * @brief Runs body(begin, end, threadId) over [0, n) split into small chunks.
+     *        Chunks are handed out dynamically so skewed vertex workloads stay balanced.
+     *        With numThreads <= 1 the whole range runs on the calling thread.
+     * 
+     * @param n Size of the index range.
+     * @param numThreads Number of threads to use (the caller counts as one of them).
+     * @param body The work to run on a sub-range.
+     * @param chunk Indices handed out at a time (1 for a few heavy items).
+     */
+    template <typename Body>
+    void parallelFor(int n, int numThreads, Body body, int chunk = 64) {
+        if (numThreads <= 1 || n < 2) {
+            body(0, n, 0);
+            return;
+        }
+        std::atomic<int> next(0);
+        auto worker = [&](int threadId) {
+            while (true) {
+                int begin = next.fetch_add(chunk);
+                if (begin >= n) break;
+                int end = begin + chunk < n ? begin + chunk : n;
+                body(begin, end, threadId);
+            }
+        };
+        std::thread* workers = new std::thread[numThreads - 1];
+        for (int t = 1; t < numThreads; t++) {
+            workers[t - 1] = std::thread(worker, t);
+        }
+        worker(0);
+        for (int t = 1; t < numThreads; t++) {
+            workers[t - 1].join();
+        }
+        delete[] workers;
+    }
+
+}
+
+#endif // PARALLEL_HPP
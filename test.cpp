@@ -3,6 +3,8 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
 #include "graph.hpp"
+#include <thread>
+#include <cmath>
 
 using namespace graph;
 
@@ -163,11 +165,16 @@ TEST_CASE("QUEUE - enqueue, dequeue, circular behavior, exceptions") {
         CHECK(q.isEmpty() == false);
     }
 
-    SUBCASE("Enqueue beyond capacity should throw") {
+    SUBCASE("Enqueue beyond capacity grows the queue") {
         q.enqueue(1);
         q.enqueue(2);
         q.enqueue(3);
-        CHECK_THROWS(q.enqueue(4));  // Should throw on overflow
+        CHECK_NOTHROW(q.enqueue(4));
+        CHECK_NOTHROW(q.enqueue(5));
+        CHECK(q.getSize() == 5);
+        for (int i = 1; i <= 5; i++) {
+            CHECK(q.dequeue() == i);
+        }
     }
 
     SUBCASE("Dequeue should return correct values in FIFO order") {
@@ -197,15 +204,38 @@ TEST_CASE("QUEUE - enqueue, dequeue, circular behavior, exceptions") {
         q.enqueue(1);
         q.enqueue(2);
         q.enqueue(3);
-        CHECK_THROWS(q.enqueue(4)); // Overflow
+        q.enqueue(4);
 
         CHECK(q.dequeue() == 1);
         CHECK(q.dequeue() == 2);
         CHECK(q.dequeue() == 3);
+        CHECK(q.dequeue() == 4);
         CHECK(q.isEmpty() == true);
 
         CHECK_THROWS(q.dequeue()); // Underflow again
     }
+
+    SUBCASE("Growth while the ring is wrapped keeps FIFO order") {
+        for (int i = 0; i < 4; i++) q.enqueue(i);
+        CHECK(q.dequeue() == 0);
+        CHECK(q.dequeue() == 1);
+        for (int i = 4; i < 1000; i++) q.enqueue(i); // wraps, then grows several times
+        for (int i = 2; i < 1000; i++) {
+            CHECK(q.dequeue() == i);
+        }
+        CHECK(q.isEmpty() == true);
+    }
+
+    SUBCASE("Default-constructed queue grows from empty") {
+        graph::Queue big;
+        for (int i = 0; i < 100000; i++) big.enqueue(i);
+        CHECK(big.getSize() == 100000);
+        bool ordered = true;
+        for (int i = 0; i < 100000; i++) {
+            if (big.dequeue() != i) ordered = false;
+        }
+        CHECK(ordered);
+    }
 }
 
 // ============================
@@ -265,8 +295,110 @@ TEST_CASE("UNION-FIND - basic operations, structure integrity, path compression"
         CHECK(uf.find(4) == 4);
     }
 
+    SUBCASE("connected and component sizes") {
+        uf.unite(0, 1);
+        uf.unite(2, 3);
+        uf.unite(3, 4);
+        CHECK(uf.connected(0, 1));
+        CHECK(uf.connected(2, 4));
+        CHECK_FALSE(uf.connected(1, 2));
+        CHECK(uf.componentSize(0) == 2);
+        CHECK(uf.componentSize(4) == 3);
+        CHECK(uf.componentSize(5) == 1);
+
+        uf.unite(1, 4);
+        CHECK(uf.connected(0, 3));
+        CHECK(uf.componentSize(2) == 5);
+
+        uf.reset();
+        CHECK(uf.componentSize(2) == 1);
+    }
+
     
 }
+
+TEST_CASE("UNION-FIND - large sets") {
+    int n = 1000000;
+    graph::UnionFind uf(n);
+
+    // chain every element to its successor in an order that keeps hanging one tree under another
+    for (int i = n - 1; i > 0; --i) {
+        uf.unite(i, i - 1);
+    }
+    CHECK(uf.componentSize(0) == n);
+    CHECK(uf.connected(0, n - 1));
+    CHECK(uf.find(n / 2) == uf.find(0));
+}
+
+TEST_CASE("CONCURRENT UNION-FIND") {
+
+    SUBCASE("single-threaded behaves like UnionFind") {
+        graph::ConcurrentUnionFind cuf(6);
+        CHECK(cuf.getSize() == 6);
+        CHECK(cuf.unite(0, 1));
+        CHECK(cuf.unite(2, 3));
+        CHECK_FALSE(cuf.unite(1, 0)); // already merged
+        CHECK(cuf.connected(0, 1));
+        CHECK_FALSE(cuf.connected(1, 2));
+        CHECK(cuf.unite(1, 3));
+        CHECK(cuf.connected(0, 2));
+        CHECK(cuf.find(0) == cuf.find(3));
+        CHECK(cuf.find(5) == 5);
+
+        cuf.reset();
+        for (int i = 0; i < 6; ++i) {
+            CHECK(cuf.find(i) == i);
+        }
+    }
+
+    SUBCASE("parallel unions give the same components as the sequential structure") {
+        int n = 20000;
+        int edges = 30000;
+        int* src = new int[edges];
+        int* dst = new int[edges];
+        unsigned int x = 12345;
+        for (int i = 0; i < edges; ++i) {
+            x = x * 1103515245u + 12345u;
+            src[i] = (int)((x >> 8) % (unsigned int)n);
+            x = x * 1103515245u + 12345u;
+            dst[i] = (int)((x >> 8) % (unsigned int)n);
+        }
+
+        graph::UnionFind expected(n);
+        for (int i = 0; i < edges; ++i) expected.unite(src[i], dst[i]);
+
+        graph::ConcurrentUnionFind cuf(n, 7);
+        const int threads = 4;
+        int merges[threads] = {0, 0, 0, 0};
+        std::thread workers[threads];
+        for (int t = 0; t < threads; ++t) {
+            workers[t] = std::thread([&, t]() {
+                for (int i = t; i < edges; i += threads) {
+                    if (cuf.unite(src[i], dst[i])) merges[t]++;
+                    cuf.connected(dst[i], src[(i * 7) % edges]); // concurrent readers
+                }
+            });
+        }
+        for (int t = 0; t < threads; ++t) workers[t].join();
+
+        // every successful merge removes one set
+        int sets = 0;
+        for (int i = 0; i < n; ++i) {
+            if (expected.find(i) == i) sets++;
+        }
+        CHECK(n - (merges[0] + merges[1] + merges[2] + merges[3]) == sets);
+
+        bool same = true;
+        for (int i = 0; i < edges; ++i) {
+            int a = src[i], b = (int)((i * 31u) % (unsigned int)n);
+            same = same && (cuf.connected(a, b) == expected.connected(a, b));
+        }
+        CHECK(same);
+        delete[] src;
+        delete[] dst;
+    }
+}
+
 // ============================
 //         EDGE SECTION
 // ============================   
@@ -323,7 +455,7 @@ TEST_CASE("EDGE - construction, field access, copying") {
 //         STACK SECTION
 // ============================   
 
-TEST_CASE("STACK - push, pop, peek, overflow, underflow") {
+TEST_CASE("STACK - push, pop, peek, growth, underflow") {
     graph::Stack s(3);  // Stack of capacity 3
 
     SUBCASE("Initially stack should be empty") {
@@ -337,11 +469,16 @@ TEST_CASE("STACK - push, pop, peek, overflow, underflow") {
         CHECK(s.isEmpty() == false);
     }
 
-    SUBCASE("Push beyond capacity should throw") {
-        s.push(1);
-        s.push(2);
-        s.push(3);
-        CHECK_THROWS(s.push(4));  // Should throw overflow
+    SUBCASE("Push beyond capacity grows the stack") {
+        for (int i = 1; i <= 100; i++) {
+            CHECK_NOTHROW(s.push(i));
+        }
+        CHECK(s.getSize() == 100);
+        CHECK(s.peek() == 100);
+        for (int i = 100; i >= 1; i--) {
+            CHECK(s.pop() == i);
+        }
+        CHECK(s.isEmpty() == true);
     }
 
     SUBCASE("Pop returns elements in LIFO order") {
@@ -429,7 +566,7 @@ TEST_CASE("PriorityQueue basic behavior") {
         pq.insert(1, 10);
         pq.insert(2, 20);
         pq.insert(3, 30);
-        pq.insert(4, 5); // should not be added (overflow)
+        CHECK_THROWS_AS(pq.insert(4, 5), std::overflow_error); // full: not added
         CHECK(pq.extractMin() == 1);
         CHECK(pq.extractMin() == 2);
         CHECK(pq.extractMin() == 3);
@@ -641,6 +778,36 @@ TEST_CASE("dijkstra basic behavior") {
         Graph shortestTree = Algorithms::dijkstra(g, 0);
         CHECK(shortestTree.getAdjList()[0] == nullptr);
     }
+
+    SUBCASE("dijkstra keeps every lazy heap entry on a dense random graph") {
+        // far more relaxations than vertices: a heap sized by V used to drop entries
+        const int V = 4096;
+        Graph g = Generators::barabasiAlbert(V, 4, 1, 100, 42);
+        Graph shortestTree = Algorithms::dijkstra(g, 0);
+        int* expected = new int[V];
+        Algorithms::bellmanFord(g, 0, expected);
+        int* distances = new int[V];
+        int* stack = new int[V];
+        int top = 0;
+        distances[0] = 0;
+        stack[top++] = 0;
+        int reached = 1;
+        while (top > 0) {
+            int u = stack[--top];
+            for (Node* n = shortestTree.getAdjList()[u]; n != nullptr; n = n->next) {
+                distances[n->vertex] = distances[u] + n->weight;
+                stack[top++] = n->vertex;
+                ++reached;
+            }
+        }
+        CHECK(reached == V);
+        bool same = true;
+        for (int v = 0; v < V; ++v) same = same && distances[v] == expected[v];
+        CHECK(same);
+        delete[] expected;
+        delete[] distances;
+        delete[] stack;
+    }
 }
 
 // ============================
@@ -700,6 +867,18 @@ TEST_CASE("PRIM") {
         Graph mst = Algorithms::prim(g);
         CHECK(mst.getAdjList()[0] == nullptr);
     }
+
+    SUBCASE("prim matches kruskal on a dense random graph") {
+        Graph g = Generators::barabasiAlbert(4096, 4, 1, 100, 42);
+        Graph byPrim = Algorithms::prim(g);
+        Graph byKruskal = Algorithms::kruskal(g);
+        long long primWeight = 0, kruskalWeight = 0;
+        for (int v = 0; v < 4096; ++v) {
+            for (Node* n = byPrim.getAdjList()[v]; n != nullptr; n = n->next) primWeight += n->weight;
+            for (Node* n = byKruskal.getAdjList()[v]; n != nullptr; n = n->next) kruskalWeight += n->weight;
+        }
+        CHECK(primWeight == kruskalWeight);
+    }
 }
 
 // ============================
@@ -769,4 +948,1870 @@ TEST_CASE("KRUSKAL") {
         Graph mst = Algorithms::kruskal(g);
         CHECK(mst.getAdjList()[0] == nullptr);
     }
-}
\ No newline at end of file
+}
+
+// ============================
+//         CSR SECTION
+// ============================ 
+
+TEST_CASE("CSR snapshot") {
+    Graph g(4);
+    g.addEdge(0, 2, 5);
+    g.addEdge(0, 1, 3);
+    g.addEdge(2, 3, 7);
+    g.addDirectedEdge(3, 1, 9);
+
+    SUBCASE("rows are sorted and weights follow their arcs") {
+        CSRGraph csr(g);
+        long long* off = csr.getOffsets();
+        int* tgt = csr.getTargets();
+        int* w = csr.getWeights();
+
+        CHECK(csr.getNumVertices() == 4);
+        CHECK(csr.getNumArcs() == 7);
+        CHECK(csr.degree(0) == 2);
+        CHECK(tgt[off[0]] == 1);
+        CHECK(w[off[0]] == 3);
+        CHECK(tgt[off[0] + 1] == 2);
+        CHECK(w[off[0] + 1] == 5);
+        CHECK(csr.degree(3) == 2);
+        CHECK(tgt[off[3]] == 1);
+        CHECK(w[off[3]] == 9);
+        CHECK(tgt[off[3] + 1] == 2);
+    }
+
+    SUBCASE("transposed rows list incoming arcs") {
+        CSRGraph rev(g, true);
+        long long* off = rev.getOffsets();
+        int* tgt = rev.getTargets();
+
+        CHECK(rev.degree(1) == 2); // 0 -> 1 and 3 -> 1
+        CHECK(tgt[off[1]] == 0);
+        CHECK(tgt[off[1] + 1] == 3);
+        CHECK(rev.degree(3) == 1); // 1 -> 3 does not exist
+    }
+
+    SUBCASE("degree of invalid vertex") {
+        CSRGraph csr(g);
+        CHECK_THROWS_AS(csr.degree(4), std::out_of_range);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - TRIANGLES
+// ============================ 
+
+TEST_CASE("TRIANGLES") {
+
+    SUBCASE("complete graph K4 has 4 triangles") {
+        Graph g(4);
+        for (int u = 0; u < 4; ++u)
+            for (int v = u + 1; v < 4; ++v)
+                g.addEdge(u, v, 1);
+
+        long long perVertex[4];
+        CHECK(Algorithms::countTriangles(g, perVertex) == 4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(perVertex[i] == 3);
+        }
+    }
+
+    SUBCASE("two triangles sharing an edge, parallel edges ignored") {
+        Graph g(5);
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 2, 1);
+        g.addEdge(2, 0, 1);
+        g.addEdge(1, 3, 1);
+        g.addEdge(2, 3, 1);
+        g.addEdge(1, 2, 4); // parallel edge
+        g.addEdge(4, 4, 1); // self loop
+
+        long long perVertex[5];
+        CHECK(Algorithms::countTriangles(g, perVertex) == 2);
+        CHECK(perVertex[0] == 1);
+        CHECK(perVertex[1] == 2);
+        CHECK(perVertex[2] == 2);
+        CHECK(perVertex[3] == 1);
+        CHECK(perVertex[4] == 0);
+    }
+
+    SUBCASE("multi-threaded count matches single-threaded") {
+        int n = 300;
+        Graph g(n);
+        for (int u = 0; u < n; ++u) {
+            g.addEdge(u, (u + 1) % n, 1);
+            g.addEdge(u, (u + 2) % n, 1);
+            g.addEdge(u, (u * 7 + 3) % n, 1);
+        }
+        long long* single = new long long[n];
+        long long* multi = new long long[n];
+        long long expected = Algorithms::countTriangles(g, single, 1);
+        CHECK(expected > 0);
+        CHECK(Algorithms::countTriangles(g, multi, 4) == expected);
+        bool same = true;
+        for (int i = 0; i < n; ++i) same = same && single[i] == multi[i];
+        CHECK(same);
+        delete[] single;
+        delete[] multi;
+    }
+
+    SUBCASE("graph without triangles") {
+        Graph g(4);
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 2, 1);
+        g.addEdge(2, 3, 1);
+        CHECK(Algorithms::countTriangles(g) == 0);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - REORDER
+// ============================ 
+
+TEST_CASE("REORDER") {
+    Graph g(6);
+    g.addEdge(0, 5, 1);
+    g.addEdge(5, 2, 2);
+    g.addEdge(2, 4, 3);
+    g.addEdge(4, 1, 4);
+    g.addEdge(0, 2, 5);
+    g.addDirectedEdge(3, 1, 6); // directed arc, 3 is otherwise isolated
+
+    ReorderStrategy strategies[4] = {REORDER_RCM, REORDER_DEGREE, REORDER_BFS, REORDER_GORDER};
+
+    SUBCASE("every strategy yields a permutation that preserves all arcs") {
+        for (int s = 0; s < 4; ++s) {
+            int perm[6];
+            Graph h = Algorithms::reorder(g, strategies[s], perm);
+
+            bool seen[6] = {false, false, false, false, false, false};
+            for (int i = 0; i < 6; ++i) {
+                REQUIRE(perm[i] >= 0);
+                REQUIRE(perm[i] < 6);
+                CHECK_FALSE(seen[perm[i]]);
+                seen[perm[i]] = true;
+            }
+
+            // every original arc u -> v (weight w) must exist as perm[u] -> perm[v] (weight w)
+            int arcs = 0;
+            for (int u = 0; u < 6; ++u) {
+                for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+                    bool found = false;
+                    for (Node* m = h.getAdjList()[perm[u]]; m != nullptr; m = m->next) {
+                        if (m->vertex == perm[n->vertex] && m->weight == n->weight) found = true;
+                    }
+                    CHECK(found);
+                    arcs++;
+                }
+            }
+            int relabeledArcs = 0;
+            for (int u = 0; u < 6; ++u) {
+                for (Node* m = h.getAdjList()[u]; m != nullptr; m = m->next) relabeledArcs++;
+            }
+            CHECK(relabeledArcs == arcs);
+        }
+    }
+
+    SUBCASE("adjacency lists of the relabeled graph are ascending") {
+        int perm[6];
+        Graph h = Algorithms::reorder(g, REORDER_GORDER, perm);
+        for (int u = 0; u < 6; ++u) {
+            for (Node* m = h.getAdjList()[u]; m != nullptr && m->next != nullptr; m = m->next) {
+                CHECK(m->vertex < m->next->vertex);
+            }
+        }
+    }
+
+    SUBCASE("degree order puts hubs first") {
+        int perm[6];
+        Algorithms::reorder(g, REORDER_DEGREE, perm);
+        CHECK(perm[2] == 0); // vertex 2 has the highest degree (3)
+    }
+
+    SUBCASE("bfs order numbers a path consecutively") {
+        Graph path(4);
+        path.addEdge(2, 0, 1);
+        path.addEdge(0, 3, 1);
+        path.addEdge(3, 1, 1);
+        int perm[4];
+        Algorithms::reorder(path, REORDER_BFS, perm);
+        CHECK(perm[0] == 0);
+        CHECK((perm[2] == 1 || perm[3] == 1));
+        CHECK(perm[1] == 3);
+    }
+
+    SUBCASE("rcm keeps the bandwidth of a shuffled path at 1") {
+        Graph path(5);
+        path.addEdge(3, 0, 1);
+        path.addEdge(0, 4, 1);
+        path.addEdge(4, 1, 1);
+        path.addEdge(1, 2, 1);
+        int perm[5];
+        Graph h = Algorithms::reorder(path, REORDER_RCM, perm);
+        for (int u = 0; u < 5; ++u) {
+            for (Node* m = h.getAdjList()[u]; m != nullptr; m = m->next) {
+                int gap = m->vertex - u;
+                CHECK((gap == 1 || gap == -1));
+            }
+        }
+    }
+}
+
+// ============================
+//     COMPRESSED SECTION
+// ============================ 
+
+// true when both encodings hold the same rows
+static bool sameRows(CompressedGraph& a, CompressedGraph& b) {
+    if (a.getNumVertices() != b.getNumVertices() || a.getNumArcs() != b.getNumArcs() ||
+        a.getMaxDegree() != b.getMaxDegree() || a.getNumBytes() != b.getNumBytes()) return false;
+    int size = a.getMaxDegree() > 0 ? a.getMaxDegree() : 1;
+    int* va = new int[size];
+    int* wa = new int[size];
+    int* vb = new int[size];
+    int* wb = new int[size];
+    bool same = true;
+    for (int v = 0; v < a.getNumVertices() && same; ++v) {
+        int da = a.decodeNeighbors(v, va, wa);
+        int db = b.decodeNeighbors(v, vb, wb);
+        same = da == db;
+        for (int i = 0; same && i < da; ++i) same = va[i] == vb[i] && wa[i] == wb[i];
+    }
+    delete[] va;
+    delete[] wa;
+    delete[] vb;
+    delete[] wb;
+    return same;
+}
+
+TEST_CASE("COMPRESSED GRAPH") {
+
+    SUBCASE("rows decode to the sorted neighbors and weights") {
+        Graph g(400);
+        g.addEdge(0, 300, 7);
+        g.addEdge(0, 5, -2);
+        g.addEdge(0, 399, 1000);
+        g.addDirectedEdge(5, 6, 1);
+
+        CompressedGraph cg(g);
+        CHECK(cg.getNumVertices() == 400);
+        CHECK(cg.getNumArcs() == 7);
+        CHECK(cg.getMaxDegree() == 3);
+        CHECK(cg.degree(0) == 3);
+        CHECK(cg.degree(1) == 0);
+
+        int vertices[3], weights[3];
+        REQUIRE(cg.decodeNeighbors(0, vertices, weights) == 3);
+        CHECK(vertices[0] == 5);
+        CHECK(weights[0] == -2);
+        CHECK(vertices[1] == 300);
+        CHECK(weights[1] == 7);
+        CHECK(vertices[2] == 399);
+        CHECK(weights[2] == 1000);
+
+        REQUIRE(cg.decodeNeighbors(5, vertices, nullptr) == 2);
+        CHECK(vertices[0] == 0);
+        CHECK(vertices[1] == 6);
+
+        CHECK_THROWS_AS(cg.degree(400), std::out_of_range);
+    }
+
+    SUBCASE("unweighted rows take a few bytes per arc") {
+        int n = 1000;
+        Graph g(n);
+        for (int i = 0; i + 1 < n; ++i) g.addEdge(i, i + 1, 1);
+        CompressedGraph cg(g);
+        CHECK(cg.getNumArcs() == 2 * (n - 1));
+        CHECK(cg.getNumBytes() <= 4 * n);
+    }
+
+    SUBCASE("bfs and dfs trees match the Graph versions") {
+        Graph g(6);
+        g.addEdge(0, 1, 2);
+        g.addEdge(0, 2, 3);
+        g.addEdge(1, 3, 4);
+        g.addEdge(2, 4, 5);
+        g.addEdge(4, 5, 6);
+        g.addEdge(3, 5, 1);
+        CompressedGraph cg(g);
+
+        Graph bfsTree = Algorithms::bfs(cg, 0);
+        Node** adj = bfsTree.getAdjList();
+        int edges = 0;
+        for (int i = 0; i < 6; ++i)
+            for (Node* n = adj[i]; n != nullptr; n = n->next) edges++;
+        CHECK(edges == 5);
+        CHECK(adj[1]->vertex == 3);
+        CHECK(adj[1]->weight == 4);
+        CHECK(adj[5] == nullptr);
+
+        Graph dfsTree = Algorithms::dfs(cg, 0);
+        edges = 0;
+        for (int i = 0; i < 6; ++i)
+            for (Node* n = dfsTree.getAdjList()[i]; n != nullptr; n = n->next) edges++;
+        CHECK(edges == 5);
+
+        CHECK_THROWS_AS(Algorithms::bfs(cg, 6), std::out_of_range);
+        CHECK_THROWS_AS(Algorithms::dfs(cg, -1), std::out_of_range);
+    }
+
+    SUBCASE("edge list constructor matches the Graph constructor") {
+        const int n = 500;
+        for (int maxWeight = 1; maxWeight <= 50; maxWeight += 49) {
+            Graph g = Generators::erdosRenyi(n, 0.02, 1, maxWeight, 3);
+            int* sources = new int[n * n];
+            int* targets = new int[n * n];
+            int* weights = new int[n * n];
+            long long m = 0;
+            // listed from the higher endpoint, in adjacency order: unsorted input
+            for (int u = n - 1; u >= 0; --u) {
+                for (Node* e = g.getAdjList()[u]; e != nullptr; e = e->next) {
+                    if (e->vertex > u) continue;
+                    sources[m] = u;
+                    targets[m] = e->vertex;
+                    weights[m++] = e->weight;
+                }
+            }
+            CompressedGraph fromGraph(g);
+            CompressedGraph fromEdges(n, sources, targets, weights, m);
+            CHECK(sameRows(fromGraph, fromEdges));
+            CompressedGraph inSmallRanges(n, sources, targets, weights, m, false, 16); // many ranges
+            CHECK(sameRows(fromGraph, inSmallRanges));
+            delete[] sources;
+            delete[] targets;
+            delete[] weights;
+        }
+    }
+
+    SUBCASE("edge list constructor: directed arcs, loops, parallel edges, invalid input") {
+        int sources[5] = {0, 0, 2, 2, 3};
+        int targets[5] = {1, 1, 2, 0, 3};
+        CompressedGraph directed(4, sources, targets, nullptr, 5, true, 1);
+        Graph g(4);
+        for (int i = 0; i < 5; ++i) g.addDirectedEdge(sources[i], targets[i], 1);
+        CompressedGraph fromGraph(g);
+        CHECK(sameRows(directed, fromGraph));
+        CHECK(directed.degree(0) == 2);
+        CHECK(directed.degree(1) == 0);
+
+        CompressedGraph undirected(4, sources, targets, nullptr, 5);
+        CHECK(undirected.getNumArcs() == 10);
+        CHECK(undirected.degree(3) == 2); // a loop is stored twice, as Graph::addEdge does
+        CHECK(undirected.degree(1) == 2);
+
+        CompressedGraph empty(3, sources, targets, nullptr, 0);
+        CHECK(empty.getNumBytes() == 3);
+        int bad[1] = {4};
+        CHECK_THROWS_AS(CompressedGraph(4, bad, targets, nullptr, 1), std::out_of_range);
+        CHECK_THROWS_AS(CompressedGraph(-1, sources, targets, nullptr, 0), std::invalid_argument);
+    }
+}
+
+// ============================
+//       GENERATORS SECTION
+// ============================ 
+
+// counts arcs and checks that every weight is inside [minWeight, maxWeight] and there are no self loops
+static long long checkGenerated(Graph& g, int minWeight, int maxWeight, bool& valid) {
+    long long arcs = 0;
+    valid = true;
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+            arcs++;
+            if (n->vertex == u || n->weight < minWeight || n->weight > maxWeight) valid = false;
+        }
+    }
+    return arcs;
+}
+
+// true when both graphs have the same adjacency lists, in the same order and with the same weights
+static bool sameAdjacency(Graph& a, Graph& b) {
+    if (a.getNumVertices() != b.getNumVertices()) return false;
+    for (int u = 0; u < a.getNumVertices(); ++u) {
+        Node* x = a.getAdjList()[u];
+        Node* y = b.getAdjList()[u];
+        while (x != nullptr && y != nullptr) {
+            if (x->vertex != y->vertex || x->weight != y->weight) return false;
+            x = x->next;
+            y = y->next;
+        }
+        if (x != nullptr || y != nullptr) return false;
+    }
+    return true;
+}
+
+TEST_CASE("GENERATORS") {
+    bool valid = false;
+
+    SUBCASE("erdos-renyi extremes and expected density") {
+        Graph empty = Generators::erdosRenyi(50, 0.0);
+        CHECK(checkGenerated(empty, 1, 1, valid) == 0);
+
+        Graph complete = Generators::erdosRenyi(20, 1.0, 3, 3);
+        CHECK(checkGenerated(complete, 3, 3, valid) == 20 * 19);
+        CHECK(valid);
+
+        Graph g = Generators::erdosRenyi(2000, 0.005, 1, 10, 7);
+        long long arcs = checkGenerated(g, 1, 10, valid);
+        CHECK(valid);
+        CHECK(arcs > 2 * 8000); // expected 2 * 9995 arcs
+        CHECK(arcs < 2 * 12000);
+
+        CHECK_THROWS_AS(Generators::erdosRenyi(10, 1.5), std::invalid_argument);
+    }
+
+    SUBCASE("same seed gives the same graph") {
+        Graph a = Generators::rmat(8, 4, 0.57, 0.19, 0.19, 1, 50, 99);
+        Graph b = Generators::rmat(8, 4, 0.57, 0.19, 0.19, 1, 50, 99);
+        CHECK(a.getNumVertices() == 256);
+        CHECK(sameAdjacency(a, b));
+        CHECK(checkGenerated(a, 1, 50, valid) <= 2 * 4 * 256);
+        CHECK(valid);
+    }
+
+    SUBCASE("barabasi-albert edge count") {
+        Graph g = Generators::barabasiAlbert(100, 3, 1, 5, 3);
+        // clique on 4 vertices (6 edges) + 3 edges for each of the other 96 vertices
+        CHECK(checkGenerated(g, 1, 5, valid) == 2 * (6 + 3 * 96));
+        CHECK(valid);
+        CHECK_THROWS_AS(Generators::barabasiAlbert(3, 3), std::invalid_argument);
+    }
+
+    SUBCASE("grid layout") {
+        Graph g = Generators::grid(3, 4, 2, 9, 5);
+        CHECK(g.getNumVertices() == 12);
+        CHECK(checkGenerated(g, 2, 9, valid) == 2 * (3 * 3 + 2 * 4));
+        CHECK(valid);
+
+        Graph path = Generators::grid(1, 5);
+        CHECK(checkGenerated(path, 1, 1, valid) == 2 * 4);
+        CHECK_THROWS_AS(Generators::grid(2, 2, 5, 1), std::invalid_argument);
+    }
+
+    SUBCASE("random geometric radius bounds") {
+        Graph none = Generators::randomGeometric(100, 0.0);
+        CHECK(checkGenerated(none, 1, 1, valid) == 0);
+
+        Graph all = Generators::randomGeometric(30, 1.5, 1, 1);
+        CHECK(checkGenerated(all, 1, 1, valid) == 30 * 29);
+
+        Graph g = Generators::randomGeometric(1000, 0.05, 1, 100, 11);
+        long long arcs = checkGenerated(g, 1, 100, valid);
+        CHECK(valid);
+        CHECK(arcs > 0);
+    }
+
+    SUBCASE("thread count does not change the graph") {
+        // sizes span several generation blocks so the parallel split is exercised
+        Graph er1 = Generators::erdosRenyi(40000, 0.0002, 1, 9, 5, 1);
+        Graph er4 = Generators::erdosRenyi(40000, 0.0002, 1, 9, 5, 4);
+        CHECK(sameAdjacency(er1, er4));
+
+        Graph rmat1 = Generators::rmat(15, 4, 0.57, 0.19, 0.19, 1, 9, 5, 1);
+        Graph rmat4 = Generators::rmat(15, 4, 0.57, 0.19, 0.19, 1, 9, 5, 4);
+        CHECK(sameAdjacency(rmat1, rmat4));
+
+        Graph ba1 = Generators::barabasiAlbert(20000, 3, 1, 9, 5, 1);
+        Graph ba4 = Generators::barabasiAlbert(20000, 3, 1, 9, 5, 4);
+        CHECK(sameAdjacency(ba1, ba4));
+
+        Graph grid1 = Generators::grid(300, 200, 1, 9, 5, 1);
+        Graph grid4 = Generators::grid(300, 200, 1, 9, 5, 4);
+        CHECK(sameAdjacency(grid1, grid4));
+
+        Graph geo1 = Generators::randomGeometric(40000, 0.005, 1, 9, 5, 1);
+        Graph geo4 = Generators::randomGeometric(40000, 0.005, 1, 9, 5, 4);
+        CHECK(sameAdjacency(geo1, geo4));
+        CHECK(checkGenerated(geo4, 1, 9, valid) > 0);
+        CHECK(valid);
+    }
+}
+
+// ============================
+//         STATS SECTION
+// ============================ 
+
+TEST_CASE("ALGORITHM STATS") {
+    Graph g(4);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 2, 2);
+    g.addEdge(2, 3, 1);
+
+#ifdef GRAPH_STATS
+    SUBCASE("bfs counts every vertex and arc once") {
+        Graph t = Algorithms::bfs(g, 0);
+        AlgorithmStats s = Algorithms::getStats();
+        CHECK(s.verticesSettled == 4);
+        CHECK(s.edgesScanned == 8);
+        CHECK(s.queuePeak == 2);
+        CHECK(s.heapInserts == 0);
+    }
+
+    SUBCASE("dijkstra counts heap traffic and successful relaxations") {
+        Graph t = Algorithms::dijkstra(g, 0);
+        AlgorithmStats s = Algorithms::getStats();
+        CHECK(s.verticesSettled == 4);
+        CHECK(s.edgesScanned == 8);
+        CHECK(s.relaxSuccesses == 4);      // 1, 2 (via 0), 2 (via 1), 3
+        CHECK(s.heapInserts == 5);         // start + 4 relaxations
+        CHECK(s.heapExtracts == s.heapInserts);
+    }
+
+    SUBCASE("counters are reset by every call") {
+        Graph t = Algorithms::dijkstra(g, 0);
+        Graph k = Algorithms::kruskal(g);
+        AlgorithmStats s = Algorithms::getStats();
+        CHECK(s.heapInserts == 0);
+        CHECK(s.relaxSuccesses == 3);      // MST edges accepted
+        CHECK(s.edgesScanned == 8);
+    }
+
+    SUBCASE("every thread keeps its own counters") {
+        Graph k = Algorithms::kruskal(g);
+        AlgorithmStats dijkstraStats = AlgorithmStats();
+        AlgorithmStats bfsStats = AlgorithmStats();
+        std::thread a([&]() {
+            for (int r = 0; r < 200; r++) Graph t = Algorithms::dijkstra(g, 0);
+            dijkstraStats = Algorithms::getStats();
+        });
+        std::thread b([&]() {
+            for (int r = 0; r < 200; r++) Graph t = Algorithms::bfs(g, 0);
+            bfsStats = Algorithms::getStats();
+        });
+        a.join();
+        b.join();
+        CHECK(dijkstraStats.heapInserts == 5);
+        CHECK(bfsStats.heapInserts == 0);
+        CHECK(bfsStats.queuePeak == 2);
+        CHECK(Algorithms::getStats().relaxSuccesses == 3); // still the kruskal call of this thread
+    }
+#else
+    SUBCASE("counters stay zero when stats are compiled out") {
+        Graph t = Algorithms::dijkstra(g, 0);
+        AlgorithmStats s = Algorithms::getStats();
+        CHECK(s.verticesSettled == 0);
+        CHECK(s.edgesScanned == 0);
+        CHECK(s.heapInserts == 0);
+        CHECK(s.findSteps == 0);
+    }
+#endif
+}
+
+// ============================
+// ALGORITHMS SECTION - COMPONENTS
+// ============================ 
+
+TEST_CASE("CONNECTED COMPONENTS") {
+
+    SUBCASE("labels are compact and ordered by smallest vertex") {
+        Graph g(7);
+        g.addEdge(5, 6, 1);
+        g.addEdge(0, 3, 1);
+        g.addEdge(3, 4, 1);
+        g.addEdge(1, 2, 1);
+        int labels[7];
+        for (int threads = 1; threads <= 4; threads += 3) {
+            CHECK(Algorithms::connectedComponents(g, labels, threads) == 3);
+            CHECK(labels[0] == 0);
+            CHECK(labels[3] == 0);
+            CHECK(labels[4] == 0);
+            CHECK(labels[1] == 1);
+            CHECK(labels[2] == 1);
+            CHECK(labels[5] == 2);
+            CHECK(labels[6] == 2);
+        }
+    }
+
+    SUBCASE("directed arcs connect weakly") {
+        Graph g(5);
+        g.addDirectedEdge(4, 0, 1);
+        g.addDirectedEdge(2, 0, 1);
+        g.addDirectedEdge(3, 1, 1);
+        int labels[5];
+        for (int threads = 1; threads <= 4; threads += 3) {
+            CHECK(Algorithms::connectedComponents(g, labels, threads) == 2);
+            CHECK(labels[0] == labels[2]);
+            CHECK(labels[0] == labels[4]);
+            CHECK(labels[1] == labels[3]);
+            CHECK(labels[0] != labels[1]);
+        }
+    }
+
+    SUBCASE("parallel Afforest matches the sequential labels") {
+        Graph g = Generators::erdosRenyi(5000, 0.0003, 1, 1, 5); // many small components and a giant one
+        int* sequential = new int[5000];
+        int* parallel = new int[5000];
+        int k = Algorithms::connectedComponents(g, sequential, 1);
+        CHECK(k > 1);
+        CHECK(Algorithms::connectedComponents(g, parallel, 4) == k);
+        bool same = true;
+        for (int i = 0; i < 5000; ++i) same = same && sequential[i] == parallel[i];
+        CHECK(same);
+        delete[] sequential;
+        delete[] parallel;
+    }
+
+    SUBCASE("empty and edgeless graphs") {
+        Graph empty(0);
+        CHECK(Algorithms::connectedComponents(empty, nullptr, 4) == 0);
+        Graph isolated(3);
+        int labels[3];
+        CHECK(Algorithms::connectedComponents(isolated, labels, 2) == 3);
+        CHECK(labels[2] == 2);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - SCC
+// ============================ 
+
+TEST_CASE("STRONGLY CONNECTED COMPONENTS") {
+
+    SUBCASE("classic example and its condensation") {
+        // {0,1,2} cycle -> {3,4} cycle -> 5, and 6 alone pointing into 0
+        Graph g(7);
+        g.addDirectedEdge(0, 1, 1);
+        g.addDirectedEdge(1, 2, 1);
+        g.addDirectedEdge(2, 0, 1);
+        g.addDirectedEdge(2, 3, 7);
+        g.addDirectedEdge(1, 4, 3);
+        g.addDirectedEdge(3, 4, 1);
+        g.addDirectedEdge(4, 3, 1);
+        g.addDirectedEdge(4, 5, 2);
+        g.addDirectedEdge(6, 0, 4);
+
+        for (int threads = 1; threads <= 4; threads += 3) {
+            int ids[7];
+            Graph dag = Algorithms::stronglyConnectedComponents(g, ids, threads);
+            CHECK(dag.getNumVertices() == 4);
+            CHECK(ids[0] == 0);
+            CHECK(ids[1] == 0);
+            CHECK(ids[2] == 0);
+            CHECK(ids[3] == 1);
+            CHECK(ids[4] == 1);
+            CHECK(ids[5] == 2);
+            CHECK(ids[6] == 3);
+
+            Node** adj = dag.getAdjList();
+            REQUIRE(adj[0] != nullptr);
+            CHECK(adj[0]->vertex == 1);
+            CHECK(adj[0]->weight == 3); // lightest of 2->3 (7) and 1->4 (3)
+            CHECK(adj[0]->next == nullptr);
+            REQUIRE(adj[1] != nullptr);
+            CHECK(adj[1]->vertex == 2);
+            CHECK(adj[2] == nullptr);
+            REQUIRE(adj[3] != nullptr);
+            CHECK(adj[3]->vertex == 0);
+        }
+    }
+
+    SUBCASE("undirected edges form one component") {
+        Graph g(4);
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 2, 1);
+        int ids[4];
+        Graph dag = Algorithms::stronglyConnectedComponents(g, ids);
+        CHECK(dag.getNumVertices() == 2);
+        CHECK(ids[0] == ids[2]);
+        CHECK(ids[3] == 1);
+    }
+
+    SUBCASE("long cycle does not overflow the stack") {
+        int n = 200000;
+        Graph g(n);
+        for (int i = 0; i < n; ++i) g.addDirectedEdge(i, (i + 1) % n, 1);
+        int* ids = new int[n];
+        Graph dag = Algorithms::stronglyConnectedComponents(g, ids);
+        CHECK(dag.getNumVertices() == 1);
+        CHECK(ids[n - 1] == 0);
+        delete[] ids;
+    }
+
+    SUBCASE("parallel coloring matches Tarjan on a random digraph") {
+        int n = 3000;
+        Graph g(n);
+        unsigned int x = 99;
+        for (int i = 0; i < 2 * n; ++i) {
+            x = x * 1103515245u + 12345u;
+            int u = (int)((x >> 8) % (unsigned int)n);
+            x = x * 1103515245u + 12345u;
+            int v = (int)((x >> 8) % (unsigned int)n);
+            g.addDirectedEdge(u, v, 1);
+        }
+        int* sequential = new int[n];
+        int* parallel = new int[n];
+        Graph a = Algorithms::stronglyConnectedComponents(g, sequential, 1);
+        Graph b = Algorithms::stronglyConnectedComponents(g, parallel, 4);
+        CHECK(a.getNumVertices() > 1);
+        CHECK(a.getNumVertices() == b.getNumVertices());
+        bool same = true;
+        for (int i = 0; i < n; ++i) same = same && sequential[i] == parallel[i];
+        CHECK(same);
+        delete[] sequential;
+        delete[] parallel;
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - MS-BFS
+// ============================ 
+
+// plain single-source BFS distances, the reference for multiSourceBfs
+static void referenceDistances(Graph& g, int source, int* dist) {
+    int V = g.getNumVertices();
+    for (int v = 0; v < V; v++) dist[v] = -1;
+    Queue queue;
+    dist[source] = 0;
+    queue.enqueue(source);
+    while (!queue.isEmpty()) {
+        int v = queue.dequeue();
+        for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) {
+            if (dist[n->vertex] == -1) {
+                dist[n->vertex] = dist[v] + 1;
+                queue.enqueue(n->vertex);
+            }
+        }
+    }
+}
+
+TEST_CASE("MULTI-SOURCE BFS") {
+
+    SUBCASE("path distances and unreachable vertices") {
+        Graph g(5);
+        g.addEdge(0, 1, 7);
+        g.addEdge(1, 2, 7);
+        g.addDirectedEdge(2, 3, 7);
+        int sources[3] = {0, 3, 4};
+        int dist[15];
+        Algorithms::multiSourceBfs(g, sources, 3, dist);
+        CHECK(dist[0 * 5 + 0] == 0);
+        CHECK(dist[0 * 5 + 2] == 2);
+        CHECK(dist[0 * 5 + 3] == 3);
+        CHECK(dist[0 * 5 + 4] == -1);
+        CHECK(dist[1 * 5 + 3] == 0);
+        CHECK(dist[1 * 5 + 0] == -1); // the arc 2 -> 3 has no way back
+        CHECK(dist[2 * 5 + 4] == 0);
+        CHECK(dist[2 * 5 + 1] == -1);
+    }
+
+    SUBCASE("matches per-source BFS across several batches") {
+        Graph er = Generators::erdosRenyi(600, 0.006, 1, 1, 11);
+        Graph grid = Generators::grid(20, 25);
+        Graph* graphs[2] = {&er, &grid};
+        for (int gi = 0; gi < 2; gi++) {
+            Graph& g = *graphs[gi];
+            int V = g.getNumVertices();
+            const int k = 150; // three batches, the last one partial
+            int sources[k];
+            for (int i = 0; i < k; i++) sources[i] = (i * 37) % V;
+            sources[k - 1] = sources[0]; // duplicate source
+            int* dist = new int[k * V];
+            int* expected = new int[V];
+            for (int threads = 1; threads <= 4; threads += 3) {
+                Algorithms::multiSourceBfs(g, sources, k, dist, threads);
+                bool same = true;
+                for (int i = 0; i < k; i++) {
+                    referenceDistances(g, sources[i], expected);
+                    for (int v = 0; v < V; v++) same = same && dist[i * V + v] == expected[v];
+                }
+                CHECK(same);
+            }
+            delete[] dist;
+            delete[] expected;
+        }
+    }
+
+    SUBCASE("invalid input") {
+        Graph g(3);
+        int dist[3];
+        int bad[1] = {3};
+        CHECK_THROWS_AS(Algorithms::multiSourceBfs(g, bad, 1, dist), std::out_of_range);
+        CHECK_THROWS_AS(Algorithms::multiSourceBfs(g, bad, -1, dist), std::invalid_argument);
+        CHECK_NOTHROW(Algorithms::multiSourceBfs(g, bad, 0, dist, 4));
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - APSP
+// ============================ 
+
+TEST_CASE("ALL-PAIRS SHORTEST PATHS") {
+    const int INF = 2147483647;
+
+    SUBCASE("small weighted graph") {
+        Graph g(5);
+        g.addEdge(0, 1, 4);
+        g.addEdge(0, 2, 1);
+        g.addEdge(2, 1, 2);
+        g.addEdge(1, 3, 5);
+        g.addEdge(1, 3, 3); // parallel edge: the lighter one counts
+        int fw[25], dj[25];
+        Algorithms::floydWarshall(g, fw);
+        Algorithms::allPairsDijkstra(g, dj);
+        CHECK(fw[0 * 5 + 1] == 3);
+        CHECK(fw[0 * 5 + 3] == 6);
+        CHECK(fw[3 * 5 + 2] == 5);
+        CHECK(fw[2 * 5 + 2] == 0);
+        CHECK(fw[0 * 5 + 4] == INF);
+        CHECK(fw[4 * 5 + 4] == 0);
+        bool same = true;
+        for (int i = 0; i < 25; ++i) same = same && fw[i] == dj[i];
+        CHECK(same);
+    }
+
+    SUBCASE("tiled Floyd-Warshall matches batch Dijkstra") {
+        // 150 vertices: two full 64-wide tiles and a partial one
+        Graph g = Generators::erdosRenyi(150, 0.03, 1, 20, 3);
+        g.addDirectedEdge(149, 0, 1);
+        int* fw = new int[150 * 150];
+        int* dj = new int[150 * 150];
+        Algorithms::allPairsDijkstra(g, dj, 1);
+        for (int threads = 1; threads <= 4; threads += 3) {
+            Algorithms::floydWarshall(g, fw, threads);
+            bool same = true;
+            for (int i = 0; i < 150 * 150; ++i) same = same && fw[i] == dj[i];
+            CHECK(same);
+        }
+        Algorithms::allPairsDijkstra(g, fw, 4);
+        bool same = true;
+        for (int i = 0; i < 150 * 150; ++i) same = same && fw[i] == dj[i];
+        CHECK(same);
+        delete[] fw;
+        delete[] dj;
+    }
+
+    SUBCASE("negative arcs and negative cycles") {
+        Graph g(4);
+        g.addDirectedEdge(0, 1, 5);
+        g.addDirectedEdge(1, 2, -3);
+        g.addDirectedEdge(0, 2, 4);
+        int dist[16];
+        Algorithms::floydWarshall(g, dist);
+        CHECK(dist[0 * 4 + 2] == 2);
+        CHECK(dist[2 * 4 + 0] == INF);
+        CHECK(dist[3 * 4 + 2] == INF);
+        CHECK_THROWS_AS(Algorithms::allPairsDijkstra(g, dist), std::invalid_argument);
+
+        g.addDirectedEdge(2, 0, -3);
+        CHECK_THROWS_AS(Algorithms::floydWarshall(g, dist), std::invalid_argument);
+    }
+
+    SUBCASE("empty graph") {
+        Graph g(0);
+        CHECK_NOTHROW(Algorithms::floydWarshall(g, nullptr, 4));
+        CHECK_NOTHROW(Algorithms::allPairsDijkstra(g, nullptr, 4));
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - NEGATIVE
+// ============================ 
+
+TEST_CASE("BELLMAN-FORD AND JOHNSON") {
+    const int INF = 2147483647;
+
+    SUBCASE("Bellman-Ford with negative arcs") {
+        Graph g(5);
+        g.addDirectedEdge(0, 1, 4);
+        g.addDirectedEdge(0, 2, 5);
+        g.addDirectedEdge(1, 3, 3);
+        g.addDirectedEdge(2, 1, -3);
+        g.addDirectedEdge(3, 2, 1);
+        int dist[5], parent[5];
+        CHECK(Algorithms::bellmanFord(g, 0, dist, parent) == true);
+        CHECK(dist[0] == 0);
+        CHECK(dist[1] == 2);
+        CHECK(dist[2] == 5);
+        CHECK(dist[3] == 5);
+        CHECK(dist[4] == INF);
+        CHECK(parent[1] == 2);
+        CHECK(parent[3] == 1);
+        CHECK(parent[0] == -1);
+        CHECK(parent[4] == -1);
+    }
+
+    SUBCASE("negative cycles are detected only when reachable") {
+        Graph g(4);
+        g.addDirectedEdge(0, 1, 1);
+        g.addDirectedEdge(2, 3, 1);
+        g.addDirectedEdge(3, 2, -2);
+        int dist[4];
+        CHECK(Algorithms::bellmanFord(g, 0, dist) == true);
+        CHECK(dist[2] == INF);
+        CHECK(Algorithms::bellmanFord(g, 2, dist) == false);
+        int all[16];
+        CHECK_THROWS_AS(Algorithms::johnson(g, all), std::invalid_argument);
+
+        Graph undirected(2);
+        undirected.addEdge(0, 1, -1); // a negative undirected edge is a 2-cycle
+        CHECK(Algorithms::bellmanFord(undirected, 0, dist) == false);
+    }
+
+    SUBCASE("Johnson matches Floyd-Warshall") {
+        Graph g(120);
+        unsigned long long x = 12345;
+        for (int i = 0; i < 600; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            int u = (int)((x >> 33) % 120);
+            int v = (int)((x >> 17) % 120);
+            if (u >= v) continue; // arcs only go up, so the graph is a DAG
+            g.addDirectedEdge(u, v, (int)((x >> 40) % 21) - 8);
+        }
+        int* fw = new int[120 * 120];
+        int* jo = new int[120 * 120];
+        Algorithms::floydWarshall(g, fw);
+        for (int threads = 1; threads <= 4; threads += 3) {
+            Algorithms::johnson(g, jo, threads);
+            bool same = true;
+            for (int i = 0; i < 120 * 120; ++i) same = same && fw[i] == jo[i];
+            CHECK(same);
+        }
+        int row[120];
+        CHECK(Algorithms::bellmanFord(g, 7, row));
+        bool same = true;
+        for (int v = 0; v < 120; ++v) same = same && row[v] == fw[7 * 120 + v];
+        CHECK(same);
+        delete[] fw;
+        delete[] jo;
+    }
+
+    SUBCASE("dijkstra rejects negative weights, invalid start") {
+        Graph g(3);
+        g.addDirectedEdge(0, 1, -1);
+        int dist[3];
+        CHECK_THROWS_AS(Algorithms::dijkstra(g, 0), std::invalid_argument);
+        CHECK_THROWS_AS(Algorithms::bellmanFord(g, 3, dist), std::out_of_range);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - PAGERANK
+// ============================ 
+
+TEST_CASE("PAGERANK") {
+
+    SUBCASE("directed cycle is uniform") {
+        Graph g(4);
+        for (int i = 0; i < 4; ++i) g.addDirectedEdge(i, (i + 1) % 4, 1);
+        double ranks[4];
+        CHECK(Algorithms::pagerank(g, ranks) >= 1);
+        for (int i = 0; i < 4; ++i) CHECK(ranks[i] == doctest::Approx(0.25));
+    }
+
+    SUBCASE("dangling vertices spread their rank") {
+        Graph g(2);
+        g.addDirectedEdge(0, 1, 1);
+        double ranks[2];
+        Algorithms::pagerank(g, ranks, 0.85, 1e-12, 1000);
+        CHECK(ranks[0] == doctest::Approx(0.5 / 1.425));
+        CHECK(ranks[0] + ranks[1] == doctest::Approx(1.0));
+    }
+
+    SUBCASE("undirected graph without teleport converges to degree / 2E") {
+        Graph g(5); // triangle 0-1-2 with a tail 2-3-4 (not bipartite, so the walk mixes)
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 2, 1);
+        g.addEdge(2, 0, 1);
+        g.addEdge(2, 3, 1);
+        g.addEdge(3, 4, 1);
+        double ranks[5];
+        int iterations = Algorithms::pagerank(g, ranks, 1.0, 1e-13, 10000);
+        CHECK(iterations < 10000);
+        int degree[5] = {2, 2, 3, 2, 1};
+        for (int i = 0; i < 5; ++i) CHECK(ranks[i] == doctest::Approx(degree[i] / 10.0));
+    }
+
+    SUBCASE("threads and iteration limit") {
+        Graph g = Generators::rmat(10, 8, 0.57, 0.19, 0.19, 1, 1, 9);
+        double* single = new double[1024];
+        double* parallel = new double[1024];
+        Algorithms::pagerank(g, single, 0.85, 1e-10, 100, 1);
+        Algorithms::pagerank(g, parallel, 0.85, 1e-10, 100, 4);
+        bool close = true;
+        double total = 0.0;
+        for (int i = 0; i < 1024; ++i) {
+            close = close && std::fabs(single[i] - parallel[i]) < 1e-9;
+            total += single[i];
+        }
+        CHECK(close);
+        CHECK(total == doctest::Approx(1.0));
+        CHECK(Algorithms::pagerank(g, single, 0.85, 0.0, 3) == 3);
+        CHECK(Algorithms::pagerank(g, single, 0.85, 1e-10, 0) == 0);
+        CHECK(single[5] == doctest::Approx(1.0 / 1024));
+        delete[] single;
+        delete[] parallel;
+    }
+
+    SUBCASE("invalid parameters and empty graph") {
+        Graph g(3);
+        double ranks[3];
+        CHECK_THROWS_AS(Algorithms::pagerank(g, ranks, 1.5), std::invalid_argument);
+        CHECK_THROWS_AS(Algorithms::pagerank(g, ranks, 0.85, 1e-9, -1), std::invalid_argument);
+        Graph empty(0);
+        CHECK(Algorithms::pagerank(empty, nullptr) == 0);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - K-CORE
+// ============================ 
+
+TEST_CASE("K-CORE") {
+
+    SUBCASE("clique with a tail and an isolated vertex") {
+        Graph g(8);
+        for (int u = 0; u < 4; ++u)
+            for (int v = u + 1; v < 4; ++v) g.addEdge(u, v, 1); // K4: core 3
+        g.addEdge(3, 4, 1);
+        g.addEdge(4, 5, 1);
+        g.addEdge(5, 6, 1);
+        g.addEdge(6, 4, 1); // triangle 4-5-6: core 2
+        int cores[8];
+        for (int threads = 1; threads <= 4; threads += 3) {
+            CHECK(Algorithms::coreNumbers(g, cores, threads) == 3);
+            CHECK(cores[0] == 3);
+            CHECK(cores[3] == 3);
+            CHECK(cores[4] == 2);
+            CHECK(cores[6] == 2);
+            CHECK(cores[7] == 0);
+        }
+    }
+
+    SUBCASE("grid and path") {
+        Graph grid = Generators::grid(6, 7);
+        Graph path = Generators::grid(1, 10);
+        int cores[42];
+        CHECK(Algorithms::coreNumbers(grid, cores, 1) == 2);
+        CHECK(cores[0] == 2);
+        CHECK(Algorithms::coreNumbers(path, cores, 4) == 1);
+        CHECK(cores[9] == 1);
+    }
+
+    SUBCASE("parallel peeling matches Batagelj-Zaversnik") {
+        Graph g = Generators::barabasiAlbert(3000, 5, 1, 1, 4);
+        Graph h = Generators::rmat(11, 6, 0.57, 0.19, 0.19, 1, 1, 4);
+        Graph* graphs[2] = {&g, &h};
+        for (int gi = 0; gi < 2; ++gi) {
+            int V = graphs[gi]->getNumVertices();
+            int* sequential = new int[V];
+            int* parallel = new int[V];
+            int k = Algorithms::coreNumbers(*graphs[gi], sequential, 1);
+            CHECK(k >= 5);
+            CHECK(Algorithms::coreNumbers(*graphs[gi], parallel, 4) == k);
+            bool same = true;
+            for (int i = 0; i < V; ++i) same = same && sequential[i] == parallel[i];
+            CHECK(same);
+            delete[] sequential;
+            delete[] parallel;
+        }
+    }
+
+    SUBCASE("every vertex of the k-core keeps k neighbors inside it") {
+        Graph g = Generators::erdosRenyi(500, 0.02, 1, 1, 8);
+        int cores[500];
+        int k = Algorithms::coreNumbers(g, cores);
+        bool valid = true;
+        for (int v = 0; v < 500; ++v) {
+            int inside = 0;
+            for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) {
+                if (cores[n->vertex] >= cores[v]) inside++;
+            }
+            valid = valid && inside >= cores[v];
+        }
+        CHECK(valid);
+        CHECK(k > 0);
+        Graph empty(0);
+        CHECK(Algorithms::coreNumbers(empty, nullptr, 4) == 0);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - BETWEENNESS
+// ============================ 
+
+TEST_CASE("BETWEENNESS") {
+
+    SUBCASE("path and star") {
+        Graph path = Generators::grid(1, 5);
+        double c[5];
+        CHECK(Algorithms::betweenness(path, c) == 0.0);
+        // ordered pairs: vertex 1 separates 0 from 2, 3, 4 in both directions
+        CHECK(c[0] == doctest::Approx(0.0));
+        CHECK(c[1] == doctest::Approx(6.0));
+        CHECK(c[2] == doctest::Approx(8.0));
+        CHECK(c[4] == doctest::Approx(0.0));
+
+        Graph star(5);
+        for (int i = 1; i < 5; ++i) star.addEdge(0, i, 1);
+        Algorithms::betweenness(star, c, false, 0, 4);
+        CHECK(c[0] == doctest::Approx(12.0));
+        CHECK(c[3] == doctest::Approx(0.0));
+    }
+
+    SUBCASE("shortest paths split evenly") {
+        Graph g(4); // square 0-1-3, 0-2-3: two shortest paths between 0 and 3
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 3, 1);
+        g.addEdge(0, 2, 1);
+        g.addEdge(2, 3, 1);
+        double c[4];
+        Algorithms::betweenness(g, c);
+        for (int i = 0; i < 4; ++i) CHECK(c[i] == doctest::Approx(1.0));
+
+        g.addEdge(0, 3, 5); // weighted: the direct edge is longer than both detours
+        Algorithms::betweenness(g, c, true);
+        CHECK(c[1] == doctest::Approx(1.0));
+        Algorithms::betweenness(g, c, false);
+        CHECK(c[1] == doctest::Approx(0.0)); // by hops the direct edge wins
+    }
+
+    SUBCASE("directed arcs and weights") {
+        Graph g(4);
+        g.addDirectedEdge(0, 1, 1);
+        g.addDirectedEdge(1, 2, 1);
+        g.addDirectedEdge(0, 2, 3);
+        g.addDirectedEdge(2, 3, 1);
+        double c[4];
+        Algorithms::betweenness(g, c, true);
+        CHECK(c[1] == doctest::Approx(2.0)); // 0->2 and 0->3
+        CHECK(c[2] == doctest::Approx(2.0)); // 0->3 and 1->3
+        Algorithms::betweenness(g, c, false);
+        CHECK(c[1] == doctest::Approx(0.0));
+        CHECK(c[2] == doctest::Approx(2.0));
+    }
+
+    SUBCASE("threads, sampling and invalid input") {
+        Graph g = Generators::barabasiAlbert(400, 3, 1, 9, 2);
+        double* exact = new double[400];
+        double* other = new double[400];
+        Algorithms::betweenness(g, exact, true, 0, 1);
+        Algorithms::betweenness(g, other, true, 0, 4);
+        bool same = true;
+        for (int i = 0; i < 400; ++i) same = same && std::fabs(exact[i] - other[i]) <= 1e-9 * (1.0 + exact[i]);
+        CHECK(same);
+
+        double bound = Algorithms::betweenness(g, other, true, 2000, 4, 7);
+        CHECK(bound > 0.0);
+        double worst = 0.0;
+        for (int i = 0; i < 400; ++i) {
+            double err = std::fabs(exact[i] - other[i]);
+            if (err > worst) worst = err;
+        }
+        CHECK(worst <= bound * 400.0 * 398.0);
+
+        CHECK_THROWS_AS(Algorithms::betweenness(g, other, false, -1), std::invalid_argument);
+        Graph zero(2);
+        zero.addEdge(0, 1, 0);
+        CHECK_THROWS_AS(Algorithms::betweenness(zero, other, true), std::invalid_argument);
+        delete[] exact;
+        delete[] other;
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - MAX FLOW
+// ============================ 
+
+// capacity of the arcs leaving the source side
+static long long cutCapacity(Graph& g, const bool* sourceSide) {
+    long long total = 0;
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+            if (sourceSide[u] && !sourceSide[n->vertex]) total += n->weight;
+        }
+    }
+    return total;
+}
+
+TEST_CASE("MAX FLOW") {
+    MaxFlowAlgorithm algorithms[2] = {MAXFLOW_DINIC, MAXFLOW_PUSH_RELABEL};
+
+    SUBCASE("textbook network") {
+        Graph g(6); // the CLRS example, max flow 23
+        g.addDirectedEdge(0, 1, 16);
+        g.addDirectedEdge(0, 2, 13);
+        g.addDirectedEdge(2, 1, 4);
+        g.addDirectedEdge(1, 3, 12);
+        g.addDirectedEdge(3, 2, 9);
+        g.addDirectedEdge(2, 4, 14);
+        g.addDirectedEdge(4, 3, 7);
+        g.addDirectedEdge(3, 5, 20);
+        g.addDirectedEdge(4, 5, 4);
+        bool side[6];
+        for (int a = 0; a < 2; ++a) {
+            CHECK(Algorithms::maxFlow(g, 0, 5, algorithms[a], side) == 23);
+            CHECK(side[0] == true);
+            CHECK(side[5] == false);
+            CHECK(cutCapacity(g, side) == 23);
+            CHECK(Algorithms::maxFlow(g, 5, 0, algorithms[a]) == 0);
+        }
+    }
+
+    SUBCASE("undirected edges carry flow both ways") {
+        Graph g(4);
+        g.addEdge(0, 1, 3);
+        g.addEdge(1, 3, 2);
+        g.addEdge(0, 2, 1);
+        g.addEdge(2, 3, 5);
+        g.addEdge(1, 2, 4);
+        for (int a = 0; a < 2; ++a) {
+            CHECK(Algorithms::maxFlow(g, 0, 3, algorithms[a]) == 4);
+            CHECK(Algorithms::maxFlow(g, 3, 0, algorithms[a]) == 4);
+        }
+    }
+
+    SUBCASE("Dinic and push-relabel agree on random networks") {
+        for (int seed = 1; seed <= 4; ++seed) {
+            Graph g = Generators::erdosRenyi(300, 0.03, 1, 50, seed);
+            Graph h = Generators::grid(15, 20, 1, 9, seed);
+            Graph* graphs[2] = {&g, &h};
+            for (int gi = 0; gi < 2; ++gi) {
+                int V = graphs[gi]->getNumVertices();
+                bool* side = new bool[V];
+                long long dinic = Algorithms::maxFlow(*graphs[gi], 0, V - 1, MAXFLOW_DINIC, side);
+                CHECK(cutCapacity(*graphs[gi], side) == dinic);
+                long long pushRelabel = Algorithms::maxFlow(*graphs[gi], 0, V - 1, MAXFLOW_PUSH_RELABEL, side);
+                CHECK(pushRelabel == dinic);
+                CHECK(cutCapacity(*graphs[gi], side) == dinic);
+                delete[] side;
+            }
+        }
+    }
+
+    SUBCASE("invalid input") {
+        Graph g(3);
+        g.addDirectedEdge(0, 1, 1);
+        CHECK_THROWS_AS(Algorithms::maxFlow(g, 0, 3), std::out_of_range);
+        CHECK_THROWS_AS(Algorithms::maxFlow(g, 1, 1), std::invalid_argument);
+        g.addDirectedEdge(1, 2, -1);
+        CHECK_THROWS_AS(Algorithms::maxFlow(g, 0, 2, MAXFLOW_PUSH_RELABEL), std::invalid_argument);
+        Graph isolated(2);
+        CHECK(Algorithms::maxFlow(isolated, 0, 1) == 0);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - MATCHING
+// ============================ 
+
+TEST_CASE("BIPARTITE MATCHING") {
+
+    SUBCASE("bipartiteness check") {
+        Graph square = Generators::grid(2, 2);
+        int side[4];
+        CHECK(Algorithms::isBipartite(square, side));
+        CHECK(side[0] == 0);
+        CHECK(side[1] == 1);
+        CHECK(side[3] == 0);
+        Graph triangle(3);
+        triangle.addEdge(0, 1, 1);
+        triangle.addEdge(1, 2, 1);
+        triangle.addEdge(2, 0, 1);
+        CHECK_FALSE(Algorithms::isBipartite(triangle));
+        int mate[3];
+        CHECK_THROWS_AS(Algorithms::maxBipartiteMatching(triangle, mate), std::invalid_argument);
+    }
+
+    SUBCASE("small graphs") {
+        Graph path = Generators::grid(1, 6);
+        int mate[12];
+        CHECK(Algorithms::maxBipartiteMatching(path, mate) == 3);
+        for (int v = 0; v < 6; ++v) CHECK(mate[mate[v]] == v);
+
+        Graph complete(7); // K(3, 4)
+        for (int u = 0; u < 3; ++u)
+            for (int v = 3; v < 7; ++v) complete.addEdge(u, v, 1);
+        CHECK(Algorithms::maxBipartiteMatching(complete, mate) == 3);
+
+        // greedy matching 0-3 would block 1; Hopcroft-Karp must reroute
+        Graph reroute(4);
+        reroute.addEdge(0, 2, 1);
+        reroute.addEdge(0, 3, 1);
+        reroute.addEdge(1, 2, 1);
+        CHECK(Algorithms::maxBipartiteMatching(reroute, mate) == 2);
+        CHECK(mate[1] == 2);
+        CHECK(mate[0] == 3);
+
+        Graph empty(0);
+        CHECK(Algorithms::maxBipartiteMatching(empty, nullptr) == 0);
+    }
+
+    SUBCASE("matches the max-flow value on random bipartite graphs") {
+        for (int seed = 1; seed <= 4; ++seed) {
+            const int L = 150, R = 120;
+            Graph g(L + R);
+            Graph flow(L + R + 2); // source L + R, sink L + R + 1
+            unsigned long long x = seed * 7919ULL;
+            for (int i = 0; i < 600; ++i) {
+                x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+                int u = (int)((x >> 33) % L);
+                int v = L + (int)((x >> 13) % R);
+                g.addEdge(u, v, 1);
+                flow.addDirectedEdge(u, v, 1);
+            }
+            for (int u = 0; u < L; ++u) flow.addDirectedEdge(L + R, u, 1);
+            for (int v = L; v < L + R; ++v) flow.addDirectedEdge(v, L + R + 1, 1);
+            int mate[L + R];
+            int matched = Algorithms::maxBipartiteMatching(g, mate);
+            CHECK(matched == Algorithms::maxFlow(flow, L + R, L + R + 1));
+            int pairs = 0;
+            bool valid = true;
+            for (int v = 0; v < L + R; ++v) {
+                if (mate[v] == -1) continue;
+                pairs++;
+                valid = valid && mate[mate[v]] == v;
+                bool adjacent = false;
+                for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) adjacent = adjacent || n->vertex == mate[v];
+                valid = valid && adjacent;
+            }
+            CHECK(valid);
+            CHECK(pairs == 2 * matched);
+        }
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - DAG
+// ============================ 
+
+// every arc must go forward in the order
+static bool isTopological(Graph& g, const int* order) {
+    int V = g.getNumVertices();
+    int* position = new int[V];
+    for (int i = 0; i < V; ++i) position[order[i]] = i;
+    bool forward = true;
+    for (int u = 0; u < V; ++u) {
+        for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) forward = forward && position[u] < position[n->vertex];
+    }
+    delete[] position;
+    return forward;
+}
+
+TEST_CASE("DAG") {
+
+    SUBCASE("topological order and cycle detection") {
+        Graph g(6);
+        g.addDirectedEdge(5, 2, 1);
+        g.addDirectedEdge(5, 0, 1);
+        g.addDirectedEdge(4, 0, 1);
+        g.addDirectedEdge(4, 1, 1);
+        g.addDirectedEdge(2, 3, 1);
+        g.addDirectedEdge(3, 1, 1);
+        int order[6];
+        for (int threads = 1; threads <= 4; threads += 3) {
+            CHECK(Algorithms::topologicalSort(g, order, threads));
+            CHECK(isTopological(g, order));
+        }
+        g.addDirectedEdge(1, 5, 1);
+        CHECK_FALSE(Algorithms::topologicalSort(g, order));
+        CHECK_FALSE(Algorithms::topologicalSort(g, order, 4));
+        Graph undirected = Generators::grid(1, 3);
+        CHECK_FALSE(Algorithms::topologicalSort(undirected, order));
+    }
+
+    SUBCASE("wide random DAG with the level-parallel variant") {
+        const int V = 5000;
+        Graph g(V);
+        unsigned long long x = 99;
+        for (int i = 0; i < 40000; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            int u = (int)((x >> 33) % V), v = (int)((x >> 13) % V);
+            if (u < v) g.addDirectedEdge(u, v, 1);
+        }
+        int* order = new int[V];
+        int* again = new int[V];
+        CHECK(Algorithms::topologicalSort(g, order, 4));
+        CHECK(isTopological(g, order));
+        CHECK(Algorithms::topologicalSort(g, again, 4));
+        bool same = true;
+        for (int i = 0; i < V; ++i) same = same && order[i] == again[i];
+        CHECK(same); // levels are sorted, so the parallel order is deterministic
+        CHECK(Algorithms::topologicalSort(g, order, 1));
+        CHECK(isTopological(g, order));
+        delete[] order;
+        delete[] again;
+    }
+
+    SUBCASE("shortest and longest paths") {
+        Graph g(6);
+        g.addDirectedEdge(0, 1, 5);
+        g.addDirectedEdge(0, 2, 3);
+        g.addDirectedEdge(1, 3, 6);
+        g.addDirectedEdge(1, 2, 2);
+        g.addDirectedEdge(2, 4, 4);
+        g.addDirectedEdge(2, 5, 2);
+        g.addDirectedEdge(2, 3, 7);
+        g.addDirectedEdge(3, 4, -1);
+        g.addDirectedEdge(4, 5, -2);
+        int dist[6], parent[6];
+        Algorithms::dagShortestPaths(g, 1, dist, false, parent);
+        CHECK(dist[0] == 2147483647);
+        CHECK(dist[1] == 0);
+        CHECK(dist[2] == 2);
+        CHECK(dist[3] == 6);
+        CHECK(dist[4] == 5);
+        CHECK(dist[5] == 3);
+        CHECK(parent[5] == 4);
+        CHECK(parent[0] == -1);
+
+        Algorithms::dagShortestPaths(g, 0, dist, true, parent);
+        CHECK(dist[3] == 14); // 0 -> 1 -> 2 -> 3
+        CHECK(dist[4] == 13);
+        CHECK(dist[5] == 11);
+        CHECK(parent[3] == 2);
+        Algorithms::dagShortestPaths(g, 4, dist, true);
+        CHECK(dist[0] == -2147483647 - 1);
+
+        int bell[6];
+        Algorithms::dagShortestPaths(g, 0, dist);
+        Algorithms::bellmanFord(g, 0, bell);
+        bool same = true;
+        for (int i = 0; i < 6; ++i) same = same && dist[i] == bell[i];
+        CHECK(same);
+    }
+
+    SUBCASE("invalid input") {
+        Graph g(3);
+        g.addDirectedEdge(0, 1, 1);
+        g.addDirectedEdge(1, 0, 1);
+        int dist[3];
+        CHECK_THROWS_AS(Algorithms::dagShortestPaths(g, 0, dist), std::invalid_argument);
+        CHECK_THROWS_AS(Algorithms::dagShortestPaths(g, 3, dist), std::out_of_range);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - COLORING
+// ============================
+
+// no edge may join two vertices of the same color (self loops aside)
+static bool isProperColoring(Graph& g, const int* colors) {
+    bool proper = true;
+    for (int u = 0; u < g.getNumVertices(); ++u) {
+        proper = proper && colors[u] >= 0;
+        for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+            proper = proper && (n->vertex == u || colors[u] != colors[n->vertex]);
+        }
+    }
+    return proper;
+}
+
+TEST_CASE("COLORING") {
+
+    SUBCASE("small graphs") {
+        int colors[6];
+        Graph bipartite = Generators::grid(2, 3);
+        CHECK(Algorithms::greedyColoring(bipartite, colors) == 2);
+        CHECK(isProperColoring(bipartite, colors));
+
+        Graph clique(5);
+        for (int u = 0; u < 5; ++u) {
+            for (int v = u + 1; v < 5; ++v) clique.addEdge(u, v, 1);
+        }
+        CHECK(Algorithms::greedyColoring(clique, colors, COLORING_LARGEST_FIRST) == 5);
+        CHECK(Algorithms::greedyColoring(clique, colors, COLORING_JONES_PLASSMANN, 4) == 5);
+        CHECK(isProperColoring(clique, colors));
+
+        Graph loops(3);
+        loops.addEdge(0, 0, 1);
+        loops.addEdge(0, 1, 1);
+        CHECK(Algorithms::greedyColoring(loops, colors) == 2);
+        CHECK(colors[2] == 0);
+
+        Graph empty(0);
+        CHECK(Algorithms::greedyColoring(empty, colors) == 0);
+    }
+
+    SUBCASE("crown graph: smallest-last stays within degeneracy + 1") {
+        // K(4,4) minus a perfect matching; degeneracy 3
+        Graph crown(8);
+        for (int u = 0; u < 4; ++u) {
+            for (int v = 0; v < 4; ++v) {
+                if (u != v) crown.addEdge(u, 4 + v, 1);
+            }
+        }
+        int colors[8];
+        int cores[8];
+        int used = Algorithms::greedyColoring(crown, colors, COLORING_SMALLEST_LAST);
+        CHECK(isProperColoring(crown, colors));
+        CHECK(used <= Algorithms::coreNumbers(crown, cores) + 1);
+    }
+
+    SUBCASE("all strategies on a skewed random graph") {
+        Graph g = Generators::rmat(12, 8);
+        const int V = g.getNumVertices();
+        int* colors = new int[V];
+        int* other = new int[V];
+        int* cores = new int[V];
+        int maxDegree = 0;
+        for (int v = 0; v < V; ++v) {
+            int degree = 0;
+            for (Node* n = g.getAdjList()[v]; n != nullptr; n = n->next) ++degree;
+            if (degree > maxDegree) maxDegree = degree;
+        }
+        int degeneracy = Algorithms::coreNumbers(g, cores);
+
+        int used = Algorithms::greedyColoring(g, colors, COLORING_LARGEST_FIRST);
+        CHECK(isProperColoring(g, colors));
+        CHECK(used <= maxDegree + 1);
+
+        used = Algorithms::greedyColoring(g, colors, COLORING_SMALLEST_LAST);
+        CHECK(isProperColoring(g, colors));
+        CHECK(used <= degeneracy + 1);
+
+        used = Algorithms::greedyColoring(g, colors, COLORING_JONES_PLASSMANN);
+        CHECK(isProperColoring(g, colors));
+        CHECK(used <= maxDegree + 1);
+        // the priorities fix the result, whatever the number of threads
+        CHECK(Algorithms::greedyColoring(g, other, COLORING_JONES_PLASSMANN, 4) == used);
+        bool same = true;
+        for (int v = 0; v < V; ++v) same = same && colors[v] == other[v];
+        CHECK(same);
+        delete[] colors;
+        delete[] other;
+        delete[] cores;
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - LOUVAIN
+// ============================
+
+// Zachary's karate club
+static Graph karateClub() {
+    static const int edges[78][2] = {
+        {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5}, {0, 6}, {0, 7}, {0, 8}, {0, 10}, {0, 11}, {0, 12}, {0, 13},
+        {0, 17}, {0, 19}, {0, 21}, {0, 31}, {1, 2}, {1, 3}, {1, 7}, {1, 13}, {1, 17}, {1, 19}, {1, 21}, {1, 30},
+        {2, 3}, {2, 7}, {2, 8}, {2, 9}, {2, 13}, {2, 27}, {2, 28}, {2, 32}, {3, 7}, {3, 12}, {3, 13}, {4, 6},
+        {4, 10}, {5, 6}, {5, 10}, {5, 16}, {6, 16}, {8, 30}, {8, 32}, {8, 33}, {9, 33}, {13, 33}, {14, 32},
+        {14, 33}, {15, 32}, {15, 33}, {18, 32}, {18, 33}, {19, 33}, {20, 32}, {20, 33}, {22, 32}, {22, 33},
+        {23, 25}, {23, 27}, {23, 29}, {23, 32}, {23, 33}, {24, 25}, {24, 27}, {24, 31}, {25, 31}, {26, 29},
+        {26, 33}, {27, 33}, {28, 31}, {28, 33}, {29, 32}, {29, 33}, {30, 32}, {30, 33}, {31, 32}, {31, 33}, {32, 33}};
+    Graph g(34);
+    for (int i = 0; i < 78; ++i) g.addEdge(edges[i][0], edges[i][1], 1);
+    return g;
+}
+
+TEST_CASE("LOUVAIN") {
+
+    SUBCASE("modularity of fixed partitions") {
+        Graph g(4);
+        g.addEdge(0, 1, 1);
+        g.addEdge(2, 3, 1);
+        int together[4] = {0, 0, 0, 0};
+        int pairs[4] = {0, 0, 1, 1};
+        int singles[4] = {0, 1, 2, 3};
+        CHECK(Algorithms::modularity(g, together) == doctest::Approx(0.0));
+        CHECK(Algorithms::modularity(g, pairs) == doctest::Approx(0.5));
+        CHECK(Algorithms::modularity(g, singles) == doctest::Approx(-0.25));
+        int bad[4] = {0, 0, 4, 1};
+        CHECK_THROWS_AS(Algorithms::modularity(g, bad), std::invalid_argument);
+    }
+
+    SUBCASE("two cliques joined by a bridge") {
+        Graph g(10);
+        for (int u = 0; u < 5; ++u) {
+            for (int v = u + 1; v < 5; ++v) {
+                g.addEdge(u, v, 1);
+                g.addEdge(u + 5, v + 5, 1);
+            }
+        }
+        g.addEdge(4, 5, 1);
+        int communities[10];
+        Algorithms::louvain(g, communities);
+        bool split = true;
+        for (int v = 0; v < 5; ++v) split = split && communities[v] == communities[0] && communities[v + 5] == communities[5];
+        CHECK(split);
+        CHECK(communities[0] != communities[5]);
+    }
+
+    SUBCASE("karate club") {
+        Graph g = karateClub();
+        int communities[34];
+        double passModularity[32];
+        int passes = Algorithms::louvain(g, communities, passModularity);
+        REQUIRE(passes >= 1);
+        bool increasing = true;
+        for (int p = 1; p < passes; ++p) increasing = increasing && passModularity[p] > passModularity[p - 1];
+        CHECK(increasing);
+        CHECK(passModularity[passes - 1] > 0.41); // the best partition scores 0.4198
+        CHECK(Algorithms::modularity(g, communities) == doctest::Approx(passModularity[passes - 1]));
+        int used = 0;
+        for (int v = 0; v < 34; ++v) {
+            if (communities[v] + 1 > used) used = communities[v] + 1;
+        }
+        CHECK(used >= 3);
+        CHECK(used <= 5);
+    }
+
+    SUBCASE("same partition for any number of threads") {
+        Graph g = Generators::rmat(12, 8);
+        const int V = g.getNumVertices();
+        int* one = new int[V];
+        int* four = new int[V];
+        double q1[32], q4[32];
+        int passes = Algorithms::louvain(g, one, q1, 32, 1);
+        CHECK(Algorithms::louvain(g, four, q4, 32, 4) == passes);
+        bool same = true;
+        for (int v = 0; v < V; ++v) same = same && one[v] == four[v];
+        CHECK(same);
+        CHECK(q1[passes - 1] == q4[passes - 1]);
+        CHECK(Algorithms::modularity(g, one) == doctest::Approx(q1[passes - 1]));
+        delete[] one;
+        delete[] four;
+    }
+
+    SUBCASE("edgeless graph and invalid input") {
+        Graph g(3);
+        int communities[3];
+        CHECK(Algorithms::louvain(g, communities) == 0);
+        CHECK(communities[2] == 2);
+        g.addEdge(0, 1, -1);
+        CHECK_THROWS_AS(Algorithms::louvain(g, communities), std::invalid_argument);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - LABEL PROPAGATION
+// ============================
+
+TEST_CASE("LABEL PROPAGATION") {
+
+    SUBCASE("two cliques joined by a bridge, and isolated vertices") {
+        Graph g(12);
+        for (int u = 0; u < 5; ++u) {
+            for (int v = u + 1; v < 5; ++v) {
+                g.addEdge(u, v, 1);
+                g.addEdge(u + 5, v + 5, 1);
+            }
+        }
+        g.addEdge(4, 5, 1);
+        int labels[12];
+        for (int threads = 1; threads <= 4; threads += 3) {
+            int iterations = Algorithms::labelPropagation(g, labels, 20, threads);
+            CHECK(iterations < 20);
+            bool split = true;
+            for (int v = 0; v < 5; ++v) split = split && labels[v] == labels[0] && labels[v + 5] == labels[5];
+            CHECK(split);
+            CHECK(labels[0] != labels[5]);
+            CHECK(labels[10] != labels[11]);
+            CHECK(labels[0] == 0); // labels are renumbered by first vertex
+        }
+    }
+
+    SUBCASE("heavier edges win") {
+        Graph g(4);
+        g.addEdge(0, 1, 5);
+        g.addEdge(0, 2, 1);
+        g.addEdge(0, 3, 1);
+        int labels[4];
+        Algorithms::labelPropagation(g, labels);
+        CHECK(labels[0] == labels[1]);
+    }
+
+    SUBCASE("geometric graph: local communities, reproducible by seed") {
+        Graph g = Generators::randomGeometric(4000, 0.03);
+        const int V = g.getNumVertices();
+        int* first = new int[V];
+        int* second = new int[V];
+        int iterations = Algorithms::labelPropagation(g, first, 50, 1, 7);
+        CHECK(iterations < 50);
+        CHECK(Algorithms::labelPropagation(g, second, 50, 1, 7) == iterations);
+        bool same = true;
+        for (int v = 0; v < V; ++v) same = same && first[v] == second[v];
+        CHECK(same);
+        CHECK(Algorithms::modularity(g, first) > 0.5);
+
+        Algorithms::labelPropagation(g, second, 50, 4, 7);
+        bool dense = true;
+        int used = 0;
+        for (int v = 0; v < V; ++v) {
+            dense = dense && second[v] <= used;
+            if (second[v] == used) ++used;
+        }
+        CHECK(dense);
+        CHECK(Algorithms::modularity(g, second) > 0.5);
+        delete[] first;
+        delete[] second;
+    }
+
+    SUBCASE("invalid input") {
+        Graph g(2);
+        g.addEdge(0, 1, -2);
+        int labels[2];
+        CHECK_THROWS_AS(Algorithms::labelPropagation(g, labels), std::invalid_argument);
+        Graph empty(0);
+        CHECK(Algorithms::labelPropagation(empty, labels) == 0);
+    }
+}
+
+// ============================
+// ALGORITHMS SECTION - BICONNECTIVITY
+// ============================
+
+// number of connected components once a vertex (or nothing, with -1) is left out
+static int componentsWithout(Graph& g, int skipped) {
+    int V = g.getNumVertices();
+    int* labels = new int[V];
+    for (int v = 0; v < V; ++v) labels[v] = -1;
+    int* stack = new int[V];
+    int count = 0;
+    for (int r = 0; r < V; ++r) {
+        if (r == skipped || labels[r] >= 0) continue;
+        int top = 0;
+        stack[top++] = r;
+        labels[r] = count;
+        while (top > 0) {
+            int u = stack[--top];
+            for (Node* n = g.getAdjList()[u]; n != nullptr; n = n->next) {
+                if (n->vertex != skipped && labels[n->vertex] < 0) {
+                    labels[n->vertex] = count;
+                    stack[top++] = n->vertex;
+                }
+            }
+        }
+        ++count;
+    }
+    delete[] labels;
+    delete[] stack;
+    return count;
+}
+
+TEST_CASE("BICONNECTIVITY") {
+
+    SUBCASE("bowtie with a tail") {
+        // triangles 0-1-2 and 2-3-4 share vertex 2; 4-5 and 5-6 hang off the second one
+        Graph g(8);
+        g.addEdge(0, 1, 1);
+        g.addEdge(1, 2, 1);
+        g.addEdge(2, 0, 1);
+        g.addEdge(2, 3, 1);
+        g.addEdge(3, 4, 1);
+        g.addEdge(4, 2, 1);
+        g.addEdge(4, 5, 1);
+        g.addEdge(5, 6, 1);
+        bool articulation[8];
+        CHECK(Algorithms::articulationPoints(g, articulation) == 3);
+        CHECK(articulation[2]);
+        CHECK(articulation[4]);
+        CHECK(articulation[5]);
+        CHECK_FALSE(articulation[0]);
+        CHECK_FALSE(articulation[7]);
+
+        int endpoints[14];
+        CHECK(Algorithms::bridges(g, endpoints) == 2);
+        bool found45 = false, found56 = false;
+        for (int i = 0; i < 2; ++i) {
+            int a = endpoints[2 * i], b = endpoints[2 * i + 1];
+            found45 = found45 || (a == 4 && b == 5) || (a == 5 && b == 4);
+            found56 = found56 || (a == 5 && b == 6) || (a == 6 && b == 5);
+        }
+        CHECK(found45);
+        CHECK(found56);
+
+        CSRGraph csr(g);
+        int* blocks = new int[csr.getNumArcs()];
+        CHECK(Algorithms::biconnectedComponents(g, blocks) == 4);
+        long long* offsets = csr.getOffsets();
+        int* targets = csr.getTargets();
+        // the block of edge (u, v), read from u's row
+        auto blockOf = [&](int u, int v) {
+            for (long long e = offsets[u]; e < offsets[u + 1]; ++e) {
+                if (targets[e] == v) return blocks[e];
+            }
+            return -2;
+        };
+        CHECK(blockOf(0, 1) == blockOf(2, 0));
+        CHECK(blockOf(1, 0) == blockOf(0, 1));
+        CHECK(blockOf(2, 3) == blockOf(4, 2));
+        CHECK(blockOf(0, 1) != blockOf(2, 3));
+        CHECK(blockOf(4, 5) != blockOf(5, 6));
+        delete[] blocks;
+    }
+
+    SUBCASE("parallel edges and self loops") {
+        Graph g(3);
+        g.addEdge(0, 1, 1);
+        g.addEdge(0, 1, 2);
+        g.addEdge(1, 2, 1);
+        g.addEdge(2, 2, 1);
+        bool articulation[3];
+        int endpoints[4];
+        CHECK(Algorithms::articulationPoints(g, articulation) == 1);
+        CHECK(articulation[1]);
+        CHECK(Algorithms::bridges(g, endpoints) == 1); // 1-2 only; the doubled 0-1 is a cycle
+        CHECK(((endpoints[0] == 1 && endpoints[1] == 2) || (endpoints[0] == 2 && endpoints[1] == 1)));
+        CSRGraph csr(g);
+        int blocks[8];
+        CHECK(Algorithms::biconnectedComponents(g, blocks) == 2);
+        CHECK(blocks[csr.getOffsets()[2 + 1] - 1] == -1); // row 2 ends with the self loop arcs
+    }
+
+    SUBCASE("deep path does not overflow") {
+        const int V = 300000;
+        Graph g = Generators::grid(1, V);
+        bool* articulation = new bool[V];
+        int* endpoints = new int[2 * (V - 1)];
+        CHECK(Algorithms::articulationPoints(g, articulation) == V - 2);
+        CHECK(Algorithms::bridges(g, endpoints) == V - 1);
+        int* blocks = new int[2 * (V - 1)];
+        CHECK(Algorithms::biconnectedComponents(g, blocks) == V - 1);
+        delete[] articulation;
+        delete[] endpoints;
+        delete[] blocks;
+    }
+
+    SUBCASE("random graphs against brute force") {
+        for (unsigned long long seed = 1; seed <= 5; ++seed) {
+            const int V = 40;
+            Graph g = Generators::erdosRenyi(V, 0.06, 1, 1, seed);
+            int base = componentsWithout(g, -1);
+            bool articulation[V];
+            Algorithms::articulationPoints(g, articulation);
+            bool cutsAgree = true;
+            for (int v = 0; v < V; ++v) {
+                // removing v drops v itself; a cut vertex leaves more components than that
+                int isolated = g.getAdjList()[v] == nullptr ? 1 : 0;
+                cutsAgree = cutsAgree && articulation[v] == (componentsWithout(g, v) > base - isolated);
+            }
+            CHECK(cutsAgree);
+
+            int endpoints[2 * (V - 1)];
+            int numBridges = Algorithms::bridges(g, endpoints);
+            bool bridgesAgree = true;
+            for (int i = 0; i < numBridges; ++i) {
+                g.removeEdge(endpoints[2 * i], endpoints[2 * i + 1]);
+                bridgesAgree = bridgesAgree && componentsWithout(g, -1) == base + 1;
+                g.addEdge(endpoints[2 * i], endpoints[2 * i + 1], 1);
+            }
+            CHECK(bridgesAgree);
+
+            // block-cut tree: every non-isolated vertex touches 1 + (number of extra blocks) blocks
+            CSRGraph csr(g);
+            long long* offsets = csr.getOffsets();
+            int* blocks = new int[csr.getNumArcs()];
+            int numBlocks = Algorithms::biconnectedComponents(g, blocks);
+            int* seen = new int[numBlocks];
+            for (int b = 0; b < numBlocks; ++b) seen[b] = -1;
+            int extra = 0, isolated = 0;
+            bool cutVertices = true;
+            for (int v = 0; v < V; ++v) {
+                int touched = 0;
+                for (long long e = offsets[v]; e < offsets[v + 1]; ++e) {
+                    if (seen[blocks[e]] != v) {
+                        seen[blocks[e]] = v;
+                        ++touched;
+                    }
+                }
+                if (touched == 0) ++isolated;
+                else extra += touched - 1;
+                cutVertices = cutVertices && articulation[v] == (touched >= 2);
+            }
+            CHECK(cutVertices);
+            CHECK(extra == numBlocks - (base - isolated));
+            delete[] seen;
+            delete[] blocks;
+        }
+    }
+}